@@ -1,3 +1,16 @@
 CXX := g++
-CXXFLAGS := -std=c++11 -Wall -Wextra -O3 -fopenmp
+CXXFLAGS := -std=c++14 -Wall -Wextra -O3 -fopenmp
 DEBUG_FLAGS := -g
+
+# Uncomment to enable the AVX2/AVX-512 paths of NTIAL_BATCH on the build machine
+# CXXFLAGS += -march=native
+
+# Grid layout of NTIAL_RAND and NTIAL_DR: flat (default), tiled or morton.
+#   Run `make clean` when switching, e.g. `make clean && make LAYOUT=morton`.
+LAYOUT ?= flat
+ifeq ($(LAYOUT),tiled)
+CXXFLAGS += -DNTIAL_LAYOUT_TILED
+endif
+ifeq ($(LAYOUT),morton)
+CXXFLAGS += -DNTIAL_LAYOUT_MORTON
+endif
@@ -0,0 +1,304 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <stdlib.h>
+#if defined(__AVX2__) || defined(__AVX512F__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+#include "ntial_batch.hpp"
+
+using std::vector;
+using std::string;
+
+/**
+ * Returns the position of the r-th (from 0) set bit of w
+ */
+static inline int select_bit(uint64_t w, int r) {
+#ifdef __BMI2__
+  return __builtin_ctzll(_pdep_u64(1ull << r, w));
+#else
+  while (r--) {
+    w &= w - 1;
+  }
+  return __builtin_ctzll(w);
+#endif
+}
+
+#if defined(__AVX2__) && !(defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__))
+/**
+ * Counts the set bits of each 64-bit element of v (nibble lookup table method)
+ */
+static inline __m256i popcount_epi64(__m256i v) {
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0F);
+  __m256i lo = _mm256_and_si256(v, low_mask);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+  __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+  return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+#endif
+
+
+/***************************
+ * NTIAL_BATCH member definitions *
+ ****************************/
+/**
+ * Constructs a batch of BATCH_LANES trials of the n*n problem.
+ */
+NTIAL_BATCH::NTIAL_BATCH(int N) {
+  n = N;
+  stop_flag = NULL;
+  interrupted = 0;
+
+  // Allocate memory, aligned for vector loads of a whole row
+  avail = (uint64_t*)aligned_alloc(64, n*BATCH_LANES*sizeof(uint64_t));
+  chosen_x.resize(2*n*BATCH_LANES);
+  chosen_y.resize(2*n*BATCH_LANES);
+
+  // Reduce every offset between two grid points to its primitive step
+  directions.resize(2*(2*n - 1)*(2*n - 1));
+  int8_t *step = directions.data();
+  for (int run = 1 - n; run < n; run++) {
+    for (int rise = 1 - n; rise < n; rise++, step += 2) {
+      int gcd = (run == 0 && rise == 0) ? 1 : std::__gcd(run, rise);
+      step[0] = run / gcd;
+      step[1] = rise / gcd;
+    }
+  }
+
+  // Initialize data
+  reset();
+
+  // obtain a seed from the system clock
+  uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+  generator.seed(seed);
+}
+
+/**
+ * Destroys the batch
+ */
+NTIAL_BATCH::~NTIAL_BATCH() {
+  free(avail);
+}
+
+/**
+ * Returns the number of trials in a batch
+ */
+int NTIAL_BATCH::lanes() {
+  return BATCH_LANES;
+}
+
+/**
+ * Resets every trial to an empty grid
+ */
+void NTIAL_BATCH::reset() {
+  uint64_t full_row = (n == 64) ? ~0ull : (1ull << n) - 1;
+  std::fill(avail, avail + n*BATCH_LANES, full_row);
+  std::fill(num_chosen, num_chosen + BATCH_LANES, 0);
+}
+
+/**
+ * Reseeds the random number generator, keyed by (s, stream, call)
+ */
+void NTIAL_BATCH::seed(uint64_t s, uint64_t stream, uint64_t call) {
+  generator.seed(s, stream, call);
+}
+
+/**
+ * Shares a flag that makes solves return early once it is set.
+ */
+void NTIAL_BATCH::set_stop_flag(const std::atomic<bool>* flag) {
+  stop_flag = flag;
+}
+
+/**
+ * Checks whether the stop flag cut a lane of the last solve short, leaving points available
+ */
+bool NTIAL_BATCH::was_interrupted(int lane) {
+  return (interrupted >> lane) & 1;
+}
+
+/**
+ * Prints the grid of one trial to stdout. '*' indicates chosen points.
+ */
+void NTIAL_BATCH::print_grid(int lane) {
+  vector<string> rows (n, string(n, ' '));
+  for (int k = 0; k < num_chosen[lane]; k++) {
+    rows[chosen_x[lane*2*n + k]][chosen_y[lane*2*n + k]] = '*';
+  }
+
+  string border (n+2, '-');
+  std::cout << border << std::endl;
+  for (auto &row : rows) {
+    std::cout << '|' << row << '|' << std::endl;
+  }
+  std::cout << border << std::endl;
+}
+
+/**
+ * Returns the number of points chosen by one trial
+ */
+int NTIAL_BATCH::get_chosen(int lane) {
+  return num_chosen[lane];
+}
+
+/**
+ * Returns the coordinates of the k-th point chosen by one trial
+ */
+void NTIAL_BATCH::get_point(int lane, int k, int &x, int &y) {
+  x = chosen_x[lane*2*n + k];
+  y = chosen_y[lane*2*n + k];
+}
+
+/**
+ * Counts the available points of every lane into counts
+ */
+void NTIAL_BATCH::count_available(int *counts) {
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+  for (int l = 0; l < BATCH_LANES; l += 8) {
+    __m512i sum = _mm512_setzero_si512();
+    for (int x = 0; x < n; x++) {
+      sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_load_si512(avail + x*BATCH_LANES + l)));
+    }
+    _mm256_storeu_si256((__m256i*)(counts + l), _mm512_cvtepi64_epi32(sum));
+  }
+#elif defined(__AVX2__)
+  for (int l = 0; l < BATCH_LANES; l += 4) {
+    __m256i sum = _mm256_setzero_si256();
+    for (int x = 0; x < n; x++) {
+      sum = _mm256_add_epi64(sum, popcount_epi64(_mm256_load_si256((__m256i*)(avail + x*BATCH_LANES + l))));
+    }
+    uint64_t lane_sums[4];
+    _mm256_storeu_si256((__m256i*)lane_sums, sum);
+    for (int k = 0; k < 4; k++) {
+      counts[l + k] = lane_sums[k];
+    }
+  }
+#else
+  std::fill(counts, counts + BATCH_LANES, 0);
+  for (int x = 0; x < n; x++) {
+    for (int l = 0; l < BATCH_LANES; l++) {
+      counts[l] += __builtin_popcountll(avail[x*BATCH_LANES + l]);
+    }
+  }
+#endif
+}
+
+/**
+ * Returns the position of a uniformly random available point of a lane with count available points
+ */
+void NTIAL_BATCH::choose_next(int lane, int count, int &x, int &y) {
+  std::uniform_int_distribution<int> distribution(0, count - 1);
+  int r = distribution(generator);
+
+  // Find the row holding the r-th available point, then the point itself
+  uint64_t row = 0;
+  int row_count;
+  for (x = 0; x < n; x++) {
+    row = avail[x*BATCH_LANES + lane];
+    row_count = __builtin_popcountll(row);
+    if (r < row_count) {
+      break;
+    }
+    r -= row_count;
+  }
+  y = select_bit(row, r);
+}
+
+/**
+ * Deletes point along line through (x, y) with given slope in one lane
+ */
+void NTIAL_BATCH::delete_line(int lane, int x0, int y0, int rise, int run) {
+  uint64_t *board = avail + lane;
+
+  if (run == 0) {
+    // The whole row x0
+    board[x0*BATCH_LANES] = 0;
+    return;
+  }
+
+  int x, y;
+  x = x0 + run;
+  y = y0 + rise;
+  while (0 <= x && x < n && 0 <= y && y < n) {
+    board[x*BATCH_LANES] &= ~(1ull << y);
+    x += run;
+    y += rise;
+  }
+  x = x0 - run;
+  y = y0 - rise;
+  while (0 <= x && x < n && 0 <= y && y < n) {
+    board[x*BATCH_LANES] &= ~(1ull << y);
+    x -= run;
+    y -= rise;
+  }
+}
+
+/**
+ * Chooses (x, y) in one lane and deletes the points that became invalid
+ */
+void NTIAL_BATCH::process_point(int lane, int x, int y) {
+  uint8_t *xs = chosen_x.data() + lane*2*n;
+  uint8_t *ys = chosen_y.data() + lane*2*n;
+  const int8_t *step;
+
+  for (int k = 0; k < num_chosen[lane]; k++) {
+    step = &directions[2*((x - xs[k] + n - 1)*(2*n - 1) + (y - ys[k] + n - 1))];
+    delete_line(lane, x, y, step[1], step[0]);
+  }
+
+  xs[num_chosen[lane]] = x;
+  ys[num_chosen[lane]] = y;
+  num_chosen[lane]++;
+  avail[x*BATCH_LANES + lane] &= ~(1ull << y);
+}
+
+/**
+ * Runs every trial until its solution is maximal.
+ *   Returns the number of trials that chose 2n points.
+ */
+int NTIAL_BATCH::solve() {
+  alignas(32) int counts[BATCH_LANES];
+  unsigned active;
+  int x, y;
+
+  do {
+    // Lanes with no available points are complete
+    count_available(counts);
+    active = 0;
+    for (int l = 0; l < BATCH_LANES; l++) {
+      if (counts[l] > 0) {
+        active |= 1u << l;
+      }
+    }
+
+    for (unsigned mask = active; mask; mask &= mask - 1) {
+      int l = __builtin_ctz(mask);
+      choose_next(l, counts[l], x, y);
+      process_point(l, x, y);
+    }
+  } while (active && !(stop_flag && stop_flag->load(std::memory_order_relaxed)));
+
+  // Lanes left with available points were cut short by the stop flag
+  interrupted = 0;
+  if (active) {
+    count_available(counts);
+    for (int l = 0; l < BATCH_LANES; l++) {
+      if (counts[l] > 0) {
+        interrupted |= 1u << l;
+      }
+    }
+  }
+
+  int solved = 0;
+  for (int l = 0; l < BATCH_LANES; l++) {
+    if (num_chosen[l] == 2*n) {
+      solved++;
+    }
+  }
+  return solved;
+}
@@ -0,0 +1,117 @@
+#ifndef NTIAL_BATCH_H
+#define NTIAL_BATCH_H
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <atomic>
+#include "ntial_random.hpp"
+
+// Number of independent trials advanced together. A multiple of 8 keeps the SIMD paths full.
+#define BATCH_LANES 8
+
+// Largest problem size a batch can hold: one 64-bit word per grid row
+#define BATCH_MAX_N 64
+
+/**
+ * A batch of independent random No-Three-In-A-Line trials run in lockstep, for n <= 64.
+ *   Each grid row of each trial is a 64-bit bitboard, and the boards are stored row by row
+ *   with the trials ("lanes") innermost, so availability counts for every lane come from
+ *   one pass over contiguous words. AVX-512 or AVX2 is used for counting when the compiler
+ *   targets it, with a scalar fallback otherwise.
+ */
+class NTIAL_BATCH {
+
+  public:
+
+    /**
+     * Constructs a batch of BATCH_LANES trials of the n*n problem. Requires n <= BATCH_MAX_N.
+     */
+    explicit NTIAL_BATCH(int n);
+
+    /**
+     * Destroys the batch
+     */
+    ~NTIAL_BATCH();
+
+    /**
+     * Returns the number of trials in a batch
+     */
+    int lanes();
+
+    /**
+     * Prints the grid of one trial to stdout. '*' indicates chosen points.
+     */
+    void print_grid(int lane);
+
+    /**
+     * Returns the number of points chosen by one trial
+     */
+    int get_chosen(int lane);
+
+    /**
+     * Returns the coordinates of the k-th point chosen by one trial
+     */
+    void get_point(int lane, int k, int &x, int &y);
+
+    /**
+     * Resets every trial to an empty grid
+     */
+    void reset();
+
+    /**
+     * Reseeds the random number generator, keyed by (s, stream, call)
+     */
+    void seed(uint64_t s, uint64_t stream = 0, uint64_t call = 0);
+
+    /**
+     * Shares a flag that makes solves return early, before the solution is maximal, once it is set.
+     *   Passing NULL removes it.
+     */
+    void set_stop_flag(const std::atomic<bool>* flag);
+
+    /**
+     * Checks whether the stop flag cut a lane of the last solve short, leaving points available
+     */
+    bool was_interrupted(int lane);
+
+    /**
+     * Runs every trial until its solution is maximal.
+     *   Returns the number of trials that chose 2n points.
+     */
+    int solve();
+
+  private:
+
+    /**
+     * Counts the available points of every lane into counts
+     */
+    void count_available(int *counts);
+
+    /**
+     * Returns the position of a uniformly random available point of a lane with count available points
+     */
+    void choose_next(int lane, int count, int &x, int &y);
+
+    /**
+     * Deletes point along line through (x, y) with given slope in one lane
+     */
+    inline void delete_line(int lane, int x, int y, int rise, int run);
+
+    /**
+     * Chooses (x, y) in one lane and deletes the points that became invalid
+     */
+    void process_point(int lane, int x, int y);
+
+    int n;                                // The size of the No-Three-In-A-Line problem
+    uint64_t* avail;                      // avail[x*BATCH_LANES + lane] has bit y set if (x, y) is available
+    std::vector<uint8_t> chosen_x;        // x-coordinates of chosen points, 2n slots per lane
+    std::vector<uint8_t> chosen_y;        // y-coordinates of chosen points, 2n slots per lane
+    int num_chosen[BATCH_LANES];          // number of points chosen by each lane
+    std::vector<int8_t> directions;       // (run, rise) primitive steps indexed by offset (dx, dy) + n-1
+    NTIAL_ENGINE generator;               // the random number generator
+    const std::atomic<bool>* stop_flag;   // when set, solves return early (may be NULL)
+    unsigned interrupted;                 // lanes the stop flag cut short in the last solve
+};
+
+#endif /* NTIAL_BATCH_H */
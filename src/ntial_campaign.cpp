@@ -0,0 +1,1250 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <omp.h>
+#include "ntial_campaign.hpp"
+#include "ntial_rand.hpp"
+#include "ntial_dr.hpp"
+#include "ntial_symm.hpp"
+#include "ntial_dispatch.hpp"
+#include "ntial_batch.hpp"
+#include "ntial_validate.hpp"
+
+using std::vector;
+using std::string;
+
+// Size of the shared prefix table (log2 of the number of slots) and visits before a prefix is dead
+#define CAMPAIGN_TT_LOG2 20
+#define CAMPAIGN_TT_VISITS 8
+
+// First line of a checkpoint file; bump the version when its layout changes
+#define CHECKPOINT_MAGIC "ntial-checkpoint"
+#define CHECKPOINT_VERSION 2
+
+// Header of a binary results file; bump the version when its layout changes
+#define RESULTS_MAGIC "NTIALRES"
+#define RESULTS_VERSION 2
+
+// Smallest encoding of a result: the fixed fields and a histogram of 2n + 1 counts for n = 2
+#define RESULT_MIN_BYTES (4 + 8 + 8 + 4 + 8 + 1 + 4 + 8*5 + 4 + 8)
+
+/**
+ * Returns the CPU time used by all threads of the process, in seconds
+ */
+static double process_cpu_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Returns the resident memory of the process, in bytes
+ */
+static long resident_bytes() {
+  long pages = 0, resident = 0;
+  std::ifstream statm ("/proc/self/statm");
+  statm >> pages >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Opens path for appending lines: a connection if it is a Unix socket, the file otherwise.
+ *   Returns -1 on failure.
+ */
+static int open_sink(const string &path, bool &is_socket) {
+  struct stat st;
+  is_socket = (stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode));
+  if (!is_socket) {
+    return open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  }
+
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    return -1;
+  }
+  strcpy(addr.sun_path, path.c_str());
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd >= 0 && connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    fd = -1;
+  }
+  return fd;
+}
+
+/**
+ * Prints the points (xs[k], ys[k]) as an n*n grid. '*' indicates chosen points.
+ */
+static void print_points(std::ostream &out, int n, const vector<int> &xs, const vector<int> &ys) {
+  vector<string> rows (n, string(n, ' '));
+  for (size_t k = 0; k < xs.size(); k++) {
+    rows[xs[k]][ys[k]] = '*';
+  }
+
+  string border (n+2, '-');
+  out << border << std::endl;
+  for (auto &row : rows) {
+    out << '|' << row << '|' << std::endl;
+  }
+  out << border << std::endl;
+}
+
+/**
+ * Writes a vector as its size followed by its elements
+ */
+template<typename T>
+static void write_vector(std::ostream &out, const vector<T> &v) {
+  out << v.size();
+  for (auto &e : v) {
+    out << ' ' << e;
+  }
+  out << '\n';
+}
+
+/**
+ * Reads a vector written by write_vector. Returns false if the stream is malformed.
+ */
+template<typename T>
+static bool read_vector(std::istream &in, vector<T> &v) {
+  size_t size;
+  if (!(in >> size)) {
+    return false;
+  }
+  v.resize(size);
+  for (auto &e : v) {
+    in >> e;
+  }
+  return (bool)in;
+}
+
+/**
+ * Writes the low bytes of value, least significant first
+ */
+static void put_bytes(std::ostream &out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    out.put((char)(value >> 8*i));
+  }
+}
+
+/**
+ * Reads a value written by put_bytes
+ */
+static uint64_t get_bytes(std::istream &in, int bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value |= (uint64_t)(unsigned char)in.get() << 8*i;
+  }
+  return value;
+}
+
+/**
+ * Returns the number of bytes left in a seekable stream, or 0 if it has failed
+ */
+static uint64_t remaining_bytes(std::istream &in) {
+  if (!in) {
+    return 0;
+  }
+  std::streampos here = in.tellg();
+  in.seekg(0, std::ios::end);
+  std::streampos end = in.tellg();
+  in.seekg(here);
+  return (here < 0 || end < here) ? 0 : (uint64_t)(end - here);
+}
+
+
+/***************************
+ * Runners: one solver per thread, behind a common interface
+ ****************************/
+/**
+ * Runs one or more trials of some solver per call
+ */
+class Runner {
+  public:
+    virtual ~Runner() {}
+
+    /**
+     * Returns the number of trials completed by each call to run()
+     */
+    virtual int trials() { return 1; }
+
+    /**
+     * Reseeds the random number generator, keyed by (s, stream, call)
+     */
+    virtual void seed(uint64_t s, uint64_t stream, uint64_t call) = 0;
+
+    /**
+     * Shares a flag that interrupts run() once it is set
+     */
+    virtual void set_stop_flag(const std::atomic<bool>* flag) = 0;
+
+    /**
+     * Resets the solver and runs its trials to completion
+     */
+    virtual void run() = 0;
+
+    /**
+     * Checks whether the stop flag cut a trial of the last run short
+     */
+    virtual bool interrupted(int trial) = 0;
+
+    /**
+     * Returns the number of points chosen by a trial of the last run
+     */
+    virtual int get_chosen(int trial) = 0;
+
+    /**
+     * Returns the coordinates of the k-th point chosen by a trial of the last run
+     */
+    virtual void get_point(int trial, int k, int &x, int &y) = 0;
+};
+
+/**
+ * Runs NTIAL_RAND, cloned from the per-n base so that its warm start and keys are shared
+ */
+class RandRunner : public Runner {
+  public:
+    RandRunner(const NTIAL_RAND &base, bool symm) : prob(base), symm(symm) {}
+    void seed(uint64_t s, uint64_t stream, uint64_t call) { prob.seed(s, stream, call); }
+    void set_stop_flag(const std::atomic<bool>* flag) { prob.set_stop_flag(flag); }
+    bool interrupted(int) { return prob.was_interrupted(); }
+    void run() { prob.reset(); symm ? prob.solve_diag_symm() : prob.solve(); }
+    int get_chosen(int) { return prob.get_chosen(); }
+    void get_point(int, int k, int &x, int &y) { prob.get_point(k, x, y); }
+  private:
+    NTIAL_RAND prob;
+    bool symm;
+};
+
+/**
+ * Runs NTIAL_DR
+ */
+class DrRunner : public Runner {
+  public:
+    explicit DrRunner(int n) : prob(n) {}
+    void seed(uint64_t s, uint64_t stream, uint64_t call) { prob.seed(s, stream, call); }
+    void set_stop_flag(const std::atomic<bool>* flag) { prob.set_stop_flag(flag); }
+    bool interrupted(int) { return prob.was_interrupted(); }
+    void run() { prob.reset(); prob.solve(); }
+    int get_chosen(int) { return prob.get_chosen(); }
+    void get_point(int, int k, int &x, int &y) { prob.get_point(k, x, y); }
+  private:
+    NTIAL_DR prob;
+};
+
+/**
+ * Runs the half-grid NTIAL_SYMM
+ */
+class SymmRunner : public Runner {
+  public:
+    explicit SymmRunner(int n) : prob(n) {}
+    void seed(uint64_t s, uint64_t stream, uint64_t call) { prob.seed(s, stream, call); }
+    void set_stop_flag(const std::atomic<bool>* flag) { prob.set_stop_flag(flag); }
+    bool interrupted(int) { return prob.was_interrupted(); }
+    void run() { prob.reset(); prob.solve(); }
+    int get_chosen(int) { return prob.get_chosen(); }
+    void get_point(int, int k, int &x, int &y) { prob.get_point(k, x, y); }
+  private:
+    NTIAL_SYMM prob;
+};
+
+/**
+ * Runs NTIAL_DISPATCH, which is specialized for small n
+ */
+class FixedRunner : public Runner {
+  public:
+    FixedRunner(int n, bool symm) : prob(n), symm(symm) {}
+    void seed(uint64_t s, uint64_t stream, uint64_t call) { prob.seed(s, stream, call); }
+    void set_stop_flag(const std::atomic<bool>* flag) { prob.set_stop_flag(flag); }
+    bool interrupted(int) { return prob.was_interrupted(); }
+    void run() { prob.reset(); symm ? prob.solve_diag_symm() : prob.solve(); }
+    int get_chosen(int) { return prob.get_chosen(); }
+    void get_point(int, int k, int &x, int &y) { prob.get_point(k, x, y); }
+  private:
+    NTIAL_DISPATCH prob;
+    bool symm;
+};
+
+/**
+ * Runs NTIAL_BATCH, BATCH_LANES trials at a time
+ */
+class BatchRunner : public Runner {
+  public:
+    explicit BatchRunner(int n) : prob(n) {}
+    int trials() { return prob.lanes(); }
+    void seed(uint64_t s, uint64_t stream, uint64_t call) { prob.seed(s, stream, call); }
+    void set_stop_flag(const std::atomic<bool>* flag) { prob.set_stop_flag(flag); }
+    bool interrupted(int trial) { return prob.was_interrupted(trial); }
+    void run() { prob.reset(); prob.solve(); }
+    int get_chosen(int trial) { return prob.get_chosen(trial); }
+    void get_point(int trial, int k, int &x, int &y) { prob.get_point(trial, k, x, y); }
+  private:
+    NTIAL_BATCH prob;
+};
+
+/**
+ * Statistics gathered by one thread for the current n.
+ *   Only the owning thread writes them, under lock so that the checkpoint writer copies a
+ *   consistent slot. The counters are relaxed atomics, so telemetry reads them without locks.
+ */
+class NTIAL_CAMPAIGN::Slot {
+  public:
+    /**
+     * Constructs a slot for problem sizes up to n_max + 1, the n of a finished campaign.
+     *   The histogram is never reallocated, so readers may index it at any time.
+     */
+    explicit Slot(int n_max) : histogram(2*n_max + 3) {}
+
+    /**
+     * Clears the statistics for problem size n
+     */
+    void reset(int n) {
+      this->n.store(n, std::memory_order_relaxed);
+      calls.store(0, std::memory_order_relaxed);
+      runs.store(0, std::memory_order_relaxed);
+      hits.store(0, std::memory_order_relaxed);
+      best.store(-1, std::memory_order_relaxed);
+      for (auto &count : histogram) {
+        count.store(0, std::memory_order_relaxed);
+      }
+      best_x.clear();
+      best_y.clear();
+    }
+
+    /**
+     * Returns the histogram of problem size n
+     */
+    vector<long> counts(int n) {
+      vector<long> copy (2*n + 1);
+      for (int k = 0; k <= 2*n; k++) {
+        copy[k] = histogram[k].load(std::memory_order_relaxed);
+      }
+      return copy;
+    }
+
+    /**
+     * Adds one to a counter. Only the owning thread writes, so no atomic read-modify-write is needed.
+     */
+    static void bump(std::atomic<long> &counter) {
+      counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::mutex lock;        // held by the owning thread while it updates the slot
+    std::atomic<int> n;     // problem size the statistics belong to
+    std::atomic<long> calls; // completed runner calls: the position in this thread's random stream
+    std::atomic<long> runs;
+    std::atomic<long> hits;
+    std::atomic<int> best;  // size of best_x/best_y: the runs of this thread that raised the global best
+    vector<std::atomic<long> > histogram;
+    vector<int> best_x;
+    vector<int> best_y;
+};
+
+
+/****************************
+ * Options member definitions *
+ ****************************/
+/**
+ * Constructs the default settings
+ */
+NTIAL_CAMPAIGN::Options::Options() {
+  n_min = 0;
+  n_max = 0;
+  solver = "rand";
+  symm = false;
+  propagate = false;
+  tt_depth = 0;
+  threads = 0;
+  seed = std::chrono::system_clock::now().time_since_epoch().count();
+  runs = 0;
+  until_maximal = false;
+  time_budget = 0;
+  cpu_time = false;
+  format = "text";
+  checkpoint_interval = 60;
+  resume = false;
+  shard_index = 0;
+  shard_count = 1;
+  validate = false;
+  telemetry_interval = 5;
+}
+
+
+/***************************
+ * NTIAL_CAMPAIGN member definitions *
+ ****************************/
+/**
+ * Constructs a campaign. The options must pass check().
+ */
+NTIAL_CAMPAIGN::NTIAL_CAMPAIGN(const Options &options) : options(options), distinct(0), done(false) {
+  threads = (options.threads > 0) ? options.threads : omp_get_max_threads();
+  tt = (options.tt_depth > 0) ? new NTIAL_TT(CAMPAIGN_TT_LOG2, CAMPAIGN_TT_VISITS) : NULL;
+  current_n = options.n_min;
+  n_start = 0;
+  budget_before = 0;
+  budget_start = 0;
+  started = 0;
+}
+
+/**
+ * Destroys a campaign
+ */
+NTIAL_CAMPAIGN::~NTIAL_CAMPAIGN() {
+  delete tt;
+  for (auto slot : slots) {
+    delete slot;
+  }
+}
+
+/**
+ * Checks that options are consistent. Returns false with a message in error otherwise.
+ */
+bool NTIAL_CAMPAIGN::check(const Options &options, string &error) {
+  const string &s = options.solver;
+  if (s != "rand" && s != "dr" && s != "symm" && s != "fixed" && s != "batch") {
+    error = "unknown solver '" + s + "'";
+  } else if (options.n_min < 2 || options.n_max < options.n_min) {
+    error = "n must be a size of at least 2 or a range min:max";
+  } else if (s == "batch" && options.n_max > BATCH_MAX_N) {
+    error = "the batch solver supports n up to " + std::to_string(BATCH_MAX_N);
+  } else if (options.symm && (s == "dr" || s == "batch")) {
+    error = "the " + s + " solver has no symmetric mode";
+  } else if (s != "rand" && (options.propagate || options.tt_depth > 0 || !options.warm_start.empty())) {
+    error = "propagation, prefix tables and warm starts need the rand solver";
+  } else if (options.runs <= 0 && !options.until_maximal && options.time_budget <= 0) {
+    error = "give a number of runs, a stop condition, a time budget, or a combination";
+  } else if (options.format != "text" && options.format != "csv" && options.format != "json") {
+    error = "unknown output format '" + options.format + "'";
+  } else if (options.resume && options.checkpoint.empty()) {
+    error = "resuming needs a checkpoint file";
+  } else if (!options.checkpoint.empty() && options.checkpoint_interval <= 0) {
+    error = "the checkpoint interval must be positive";
+  } else if (options.shard_count < 1 || options.shard_index < 0 || options.shard_index >= options.shard_count) {
+    error = "the shard must be k/N with 0 <= k < N";
+  } else if (!options.telemetry.empty() && options.telemetry_interval <= 0) {
+    error = "the telemetry interval must be positive";
+  } else {
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Returns the settings of the campaign, with the seed and thread count of a resumed checkpoint
+ */
+const NTIAL_CAMPAIGN::Options& NTIAL_CAMPAIGN::get_options() {
+  return options;
+}
+
+/**
+ * Returns the results of the sweep so far, including those restored from a checkpoint
+ */
+const vector<NTIAL_CAMPAIGN::Result>& NTIAL_CAMPAIGN::get_results() {
+  return results;
+}
+
+/**
+ * Returns the settings that every shard of a campaign shares, as a line of "key value" pairs.
+ *   The seed, shard, thread count, time budget and output format are left out.
+ */
+string NTIAL_CAMPAIGN::signature(const Options &options) {
+  std::ostringstream sig;
+  sig << "n " << options.n_min << ':' << options.n_max << " solver " << options.solver
+      << " symm " << options.symm << " propagate " << options.propagate << " tt " << options.tt_depth
+      << " runs " << options.runs << " until_maximal " << options.until_maximal
+      << " cpu_time " << options.cpu_time << " warm_start " << options.warm_start;
+  return sig.str();
+}
+
+/**
+ * Returns the settings a resumed campaign must share with its checkpoint.
+ *   The time budget and output format may change between runs; the seed and
+ *   thread count are taken from the checkpoint.
+ */
+string NTIAL_CAMPAIGN::checkpoint_signature() {
+  return "shard " + std::to_string(options.shard_index) + '/' + std::to_string(options.shard_count)
+         + ' ' + signature(options);
+}
+
+/**
+ * Returns the time budget used so far, including time used before a resume
+ */
+double NTIAL_CAMPAIGN::budget_used() {
+  double now = options.cpu_time ? process_cpu_seconds() : omp_get_wtime();
+  return budget_before + now - budget_start;
+}
+
+/**
+ * Writes the checkpoint file, replacing the previous one atomically.
+ *   Solver threads are held only while their slot is copied; the file is written without locks.
+ */
+bool NTIAL_CAMPAIGN::write_checkpoint() {
+  std::ostringstream out;
+  out << std::setprecision(17);
+  out << CHECKPOINT_MAGIC << ' ' << CHECKPOINT_VERSION << '\n' << checkpoint_signature() << '\n'
+      << "seed " << options.seed << '\n' << "threads " << threads << '\n' << "budget " << budget_used() << '\n';
+  {
+    std::lock_guard<std::mutex> guard(state_lock);
+    out << "current " << current_n << ' ' << omp_get_wtime() - n_start << '\n';
+
+    // Results of an n cut short by the time budget are left out: a resume completes that n
+    size_t count = 0;
+    for (auto &r : results) {
+      count += (r.n < current_n);
+    }
+    out << "results " << count << '\n';
+    for (auto &r : results) {
+      if (r.n >= current_n) {
+        continue;
+      }
+      out << "result " << r.n << ' ' << r.runs << ' ' << r.hits << ' ' << r.best << ' '
+          << r.seconds << ' ' << r.expired << '\n';
+      write_vector(out, r.histogram);
+      write_vector(out, r.best_x);
+      write_vector(out, r.best_y);
+      out << r.solutions.size() << '\n';
+      for (auto &cells : r.solutions) {
+        write_vector(out, cells);
+      }
+    }
+
+    // Slots are copied before the solution set: every hit they count is already in the set
+    for (auto s : slots) {
+      std::lock_guard<std::mutex> slot_guard(s->lock);
+      if (s->n.load() == current_n) {
+        out << "slot " << current_n << ' ' << s->calls.load() << ' ' << s->runs.load() << ' '
+            << s->hits.load() << ' ' << s->best.load() << '\n';
+        write_vector(out, s->counts(current_n));
+        write_vector(out, s->best_x);
+        write_vector(out, s->best_y);
+      } else {
+        out << "slot " << current_n << " 0 0 0 -1\n";
+        write_vector(out, vector<long>(2*current_n + 1, 0));
+        write_vector(out, vector<int>());
+        write_vector(out, vector<int>());
+      }
+    }
+
+    std::set<vector<int> > copy;
+    {
+      std::lock_guard<std::mutex> solutions_guard(solutions_lock);
+      copy = solutions;
+    }
+    out << "solutions " << copy.size() << '\n';
+    for (auto &cells : copy) {
+      write_vector(out, cells);
+    }
+  }
+  out << "end\n";
+
+  string tmp = options.checkpoint + ".tmp";
+  std::ofstream file (tmp);
+  file << out.str();
+  file.close();
+  if (!file) {
+    std::cerr << tmp << ": cannot write checkpoint" << std::endl;
+    return false;
+  }
+  if (std::rename(tmp.c_str(), options.checkpoint.c_str()) != 0) {
+    std::cerr << options.checkpoint << ": cannot replace checkpoint" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Restores the campaign from the checkpoint file, if it exists.
+ *   Returns false if it exists but cannot be used.
+ */
+bool NTIAL_CAMPAIGN::load_checkpoint() {
+  const string &path = options.checkpoint;
+  std::ifstream in (path);
+  if (!in) {
+    // Nothing to resume: start afresh
+    return true;
+  }
+
+  string magic, sig, word;
+  int version = 0;
+  in >> magic >> version >> std::ws;
+  if (magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION) {
+    std::cerr << path << ": not a checkpoint of version " << CHECKPOINT_VERSION << std::endl;
+    return false;
+  }
+  std::getline(in, sig);
+  if (sig != checkpoint_signature()) {
+    std::cerr << path << ": written by a campaign with other settings (" << sig << ")" << std::endl;
+    return false;
+  }
+
+  uint64_t seed = 0;
+  int saved_threads = 0, n = 0;
+  double used = 0, seconds = 0;
+  size_t count = 0;
+  in >> word >> seed >> word >> saved_threads >> word >> used >> word >> n >> seconds >> word >> count;
+  if (!in || saved_threads < 1 || n < options.n_min || n > options.n_max + 1) {
+    std::cerr << path << ": malformed checkpoint" << std::endl;
+    return false;
+  }
+  if (options.threads > 0 && options.threads != saved_threads) {
+    std::cerr << path << ": written by " << saved_threads << " threads; resume with as many" << std::endl;
+    return false;
+  }
+
+  bool ok = true;
+  vector<Result> restored (count);
+  for (auto &r : restored) {
+    size_t m = 0;
+    in >> word >> r.n >> r.runs >> r.hits >> r.best >> r.seconds >> r.expired;
+    ok = ok && read_vector(in, r.histogram) && read_vector(in, r.best_x) && read_vector(in, r.best_y) && (in >> m);
+    r.solutions.resize(ok ? m : 0);
+    for (auto &cells : r.solutions) {
+      ok = ok && read_vector(in, cells);
+    }
+  }
+
+  vector<Slot*> restored_slots;
+  for (int t = 0; t < saved_threads; t++) {
+    Slot *s = new Slot(options.n_max);
+    restored_slots.push_back(s);
+    int slot_n = 0, best = -1;
+    long calls = 0, runs = 0, hits = 0;
+    vector<long> histogram;
+    vector<int> best_x, best_y;
+    in >> word >> slot_n >> calls >> runs >> hits >> best;
+    ok = ok && read_vector(in, histogram) && read_vector(in, best_x) && read_vector(in, best_y);
+    ok = ok && slot_n == n && histogram.size() == (size_t)(2*n + 1);
+    if (ok) {
+      s->reset(n);
+      s->calls = calls;
+      s->runs = runs;
+      s->hits = hits;
+      s->best = best;
+      s->best_x = best_x;
+      s->best_y = best_y;
+      for (int k = 0; k <= 2*n; k++) {
+        s->histogram[k] = histogram[k];
+      }
+    }
+  }
+
+  std::set<vector<int> > restored_solutions;
+  in >> word >> count;
+  for (size_t k = 0; ok && k < count; k++) {
+    vector<int> cells;
+    ok = read_vector(in, cells);
+    restored_solutions.insert(cells);
+  }
+  in >> word;
+
+  if (!ok || !in || word != "end") {
+    std::cerr << path << ": malformed checkpoint" << std::endl;
+    for (auto s : restored_slots) {
+      delete s;
+    }
+    return false;
+  }
+
+  options.seed = seed;
+  threads = saved_threads;
+  results = restored;
+  slots = restored_slots;
+  solutions = restored_solutions;
+  distinct = solutions.size();
+  current_n = n;
+  n_start = omp_get_wtime() - seconds;
+  budget_before = used;
+  return true;
+}
+
+/**
+ * Rewrites the checkpoint every checkpoint_interval seconds until the sweep is done
+ */
+void NTIAL_CAMPAIGN::checkpoint_loop() {
+  while (!done.load()) {
+    double next = omp_get_wtime() + options.checkpoint_interval;
+    while (!done.load() && omp_get_wtime() < next) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!done.load()) {
+      write_checkpoint();
+    }
+  }
+}
+
+/**
+ * Sends a line of progress to the telemetry sink every telemetry_interval seconds,
+ *   and a last one when the sweep is done
+ */
+void NTIAL_CAMPAIGN::telemetry_loop() {
+  bool is_socket;
+  int fd = open_sink(options.telemetry, is_socket);
+  if (fd < 0) {
+    std::cerr << options.telemetry << ": cannot open telemetry sink" << std::endl;
+    return;
+  }
+
+  // Runs of every thread at the last line, to report rates
+  vector<int> last_n (threads);
+  vector<long> last_runs (threads);
+  for (int t = 0; t < threads; t++) {
+    last_n[t] = slots[t]->n.load(std::memory_order_relaxed);
+    last_runs[t] = slots[t]->runs.load(std::memory_order_relaxed);
+  }
+  double last = omp_get_wtime();
+
+  bool final = false;
+  while (!final) {
+    double next = last + options.telemetry_interval;
+    while (!done.load() && omp_get_wtime() < next) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    final = done.load();
+    double now = omp_get_wtime();
+    double elapsed = now - last;
+    last = now;
+
+    // The sweep only moves forward, so the largest n of any slot is the current one
+    int n = options.n_min;
+    for (auto s : slots) {
+      n = std::max(n, s->n.load(std::memory_order_relaxed));
+    }
+
+    std::ostringstream line;
+    long runs = 0, hits = 0;
+    int best = -1;
+    vector<long> histogram (2*n + 1, 0);
+    line << "{\"seconds\":" << now - started << ",\"n\":" << n << ",\"threads\":[";
+    for (int t = 0; t < threads; t++) {
+      Slot *s = slots[t];
+      int slot_n = s->n.load(std::memory_order_relaxed);
+      long slot_runs = s->runs.load(std::memory_order_relaxed);
+      long delta = (slot_n == last_n[t]) ? slot_runs - last_runs[t] : slot_runs;
+      last_n[t] = slot_n;
+      last_runs[t] = slot_runs;
+      line << (t ? "," : "") << "{\"n\":" << slot_n << ",\"runs\":" << slot_runs
+           << ",\"runs_per_sec\":" << delta / elapsed << '}';
+
+      if (slot_n == n) {
+        runs += slot_runs;
+        hits += s->hits.load(std::memory_order_relaxed);
+        best = std::max(best, s->best.load(std::memory_order_relaxed));
+        for (int k = 0; k <= 2*n; k++) {
+          histogram[k] += s->histogram[k].load(std::memory_order_relaxed);
+        }
+      }
+    }
+    line << "],\"runs\":" << runs << ",\"histogram\":[";
+    for (int k = 0; k <= 2*n; k++) {
+      line << (k ? "," : "") << histogram[k];
+    }
+    line << "],\"best\":" << best << ",\"hits\":" << hits
+         << ",\"distinct\":" << distinct.load(std::memory_order_relaxed)
+         << ",\"rss_bytes\":" << resident_bytes() << "}\n";
+
+    string text = line.str();
+    ssize_t written = is_socket ? send(fd, text.data(), text.size(), MSG_NOSIGNAL)
+                                : write(fd, text.data(), text.size());
+    if (written != (ssize_t)text.size()) {
+      std::cerr << options.telemetry << ": telemetry sink closed" << std::endl;
+      break;
+    }
+  }
+  close(fd);
+}
+
+/**
+ * Runs the sweep, printing each result to out as soon as its n is done
+ */
+bool NTIAL_CAMPAIGN::run(std::ostream &out) {
+  bool symm = options.symm || options.solver == "symm";
+
+  if (options.resume && !load_checkpoint()) {
+    return false;
+  }
+  if (slots.empty()) {
+    for (int t = 0; t < threads; t++) {
+      slots.push_back(new Slot(options.n_max));
+      slots.back()->reset(current_n);
+    }
+    n_start = omp_get_wtime();
+  }
+  for (size_t k = 0; k < results.size(); k++) {
+    print_result(out, results[k], options.format, k == 0);
+  }
+
+  NTIAL_RAND *base = NULL;
+  std::atomic<long> next_run (0);
+  std::atomic<bool> stop (false);      // ends the current n, interrupting runs in progress
+  std::atomic<bool> expired (false);   // set once the time budget has run out
+  std::atomic<int> best (-1);          // best size found for the current n
+  std::atomic<long> invalid (0);       // solutions rejected by validation
+  bool failed = false;
+  bool finished = false;
+  int first_n = current_n;
+
+  // This shard's slice of the run limit
+  long quota = options.runs * (options.shard_index + 1) / options.shard_count
+             - options.runs * options.shard_index / options.shard_count;
+
+  // The watchdog ends the campaign when the time budget runs out
+  budget_start = options.cpu_time ? process_cpu_seconds() : omp_get_wtime();
+  std::thread watchdog;
+  if (options.time_budget > 0) {
+    expired = (budget_before >= options.time_budget);
+    watchdog = std::thread([&]() {
+      double used = budget_used();
+      while (!done.load() && used < options.time_budget) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        used = budget_used();
+      }
+      if (used >= options.time_budget) {
+        expired = true;
+        stop = true;
+      }
+    });
+  }
+
+  std::thread writer;
+  if (!options.checkpoint.empty()) {
+    writer = std::thread(&NTIAL_CAMPAIGN::checkpoint_loop, this);
+  }
+
+  started = omp_get_wtime();
+  std::thread reporter;
+  if (!options.telemetry.empty()) {
+    reporter = std::thread(&NTIAL_CAMPAIGN::telemetry_loop, this);
+  }
+
+  // One team of threads serves the whole sweep
+  #pragma omp parallel num_threads(threads)
+  {
+    int t = omp_get_thread_num();
+
+    for (int n = first_n; n <= options.n_max; n++) {
+      // Per-n setup shared by every thread
+      #pragma omp single
+      {
+        if (options.solver == "rand") {
+          base = new NTIAL_RAND(n);
+          base->set_propagation(options.propagate);
+          if (tt) {
+            tt->clear();
+            base->set_transposition_table(tt, options.tt_depth);
+          }
+          if (!options.warm_start.empty() && !base->load_seed(options.warm_start, symm)) {
+            failed = true;
+          }
+        }
+
+        // Continue from the statistics of a resumed n
+        long runs = 0;
+        long hits = 0;
+        int top = -1;
+        for (auto s : slots) {
+          if (s->n == n) {
+            runs += s->runs;
+            hits += s->hits;
+            top = std::max(top, s->best.load());
+          }
+        }
+        next_run = runs;
+        best = top;
+        {
+          std::lock_guard<std::mutex> guard(solutions_lock);
+          distinct = solutions.size();
+        }
+        stop = expired.load() || (options.until_maximal && hits > 0);
+        finished = failed || expired.load();
+      }
+      if (finished) {
+        break;
+      }
+
+      Runner *runner;
+      if (options.solver == "rand") {
+        runner = new RandRunner(*base, symm);
+      } else if (options.solver == "dr") {
+        runner = new DrRunner(n);
+      } else if (options.solver == "symm") {
+        runner = new SymmRunner(n);
+      } else if (options.solver == "fixed") {
+        runner = new FixedRunner(n, symm);
+      } else {
+        runner = new BatchRunner(n);
+      }
+      runner->set_stop_flag(&stop);
+
+      Slot &slot = *slots[t];
+      {
+        std::lock_guard<std::mutex> guard(slot.lock);
+        if (slot.n != n) {
+          slot.reset(n);
+        }
+      }
+
+      // Solutions of symmetric runs are maximal only among symmetric sets, and propagation
+      //   ends a run early once it cannot reach 2n, so neither is checked for maximality
+      NTIAL_VALIDATE validator (n);
+      bool maximal = !symm && !options.propagate;
+      vector<int> xs (2*n), ys (2*n), cells (2*n);
+      while (!stop.load(std::memory_order_relaxed)) {
+        // Claim the next trials
+        long first = next_run.fetch_add(runner->trials());
+        long count = runner->trials();
+        if (options.runs > 0) {
+          count = std::min(count, quota - first);
+          if (count <= 0) {
+            break;
+          }
+        }
+
+        uint64_t stream = options.shard_index + (uint64_t)options.shard_count*t;
+        runner->seed(options.seed, ((uint64_t)n << 32) | stream, slot.calls);
+        runner->run();
+
+        // Trials cut short by the stop flag are incomplete and dropped. A call with none
+        //   complete is not counted, so a resumed campaign replays it.
+        int complete = 0;
+        for (int trial = 0; trial < count; trial++) {
+          complete += !runner->interrupted(trial);
+        }
+        if (complete == 0) {
+          break;
+        }
+
+        // Solutions are stored before they are counted, so a checkpoint never counts a hit it lacks
+        for (int trial = 0; trial < count; trial++) {
+          if (!runner->interrupted(trial) && runner->get_chosen(trial) == 2*n) {
+            for (int k = 0; k < 2*n; k++) {
+              runner->get_point(trial, k, xs[k], ys[k]);
+              cells[k] = xs[k]*n + ys[k];
+            }
+            if (options.validate && !validator.validate(xs, ys, maximal)) {
+              #pragma omp critical
+              std::cerr << "n = " << n << ": invalid solution: " << validator.get_error() << std::endl;
+              invalid++;
+            }
+            std::sort(cells.begin(), cells.end());
+            std::lock_guard<std::mutex> guard(solutions_lock);
+            solutions.insert(cells);
+            distinct.store(solutions.size(), std::memory_order_relaxed);
+          }
+        }
+
+        std::lock_guard<std::mutex> guard(slot.lock);
+        Slot::bump(slot.calls);
+        for (int trial = 0; trial < count; trial++) {
+          if (runner->interrupted(trial)) {
+            continue;
+          }
+          int chosen = runner->get_chosen(trial);
+          Slot::bump(slot.runs);
+          Slot::bump(slot.histogram[chosen]);
+
+          // Only the thread that raises the global best copies its solution
+          int global = best.load(std::memory_order_relaxed);
+          bool improved = false;
+          while (chosen > global && !improved) {
+            improved = best.compare_exchange_weak(global, chosen);
+          }
+          if (improved) {
+            slot.best = chosen;
+            slot.best_x.resize(chosen);
+            slot.best_y.resize(chosen);
+            for (int k = 0; k < chosen; k++) {
+              runner->get_point(trial, k, slot.best_x[k], slot.best_y[k]);
+            }
+            if (options.validate && chosen < 2*n && !validator.validate(slot.best_x, slot.best_y, maximal)) {
+              #pragma omp critical
+              std::cerr << "n = " << n << ": invalid solution: " << validator.get_error() << std::endl;
+              invalid++;
+            }
+          }
+          if (chosen == 2*n) {
+            Slot::bump(slot.hits);
+            if (options.until_maximal) {
+              stop = true;
+            }
+          }
+        }
+      }
+      delete runner;
+
+      // Merge the statistics of every thread
+      #pragma omp barrier
+      #pragma omp single
+      {
+        std::lock_guard<std::mutex> guard(state_lock);
+        Result result;
+        result.n = n;
+        result.runs = 0;
+        result.hits = 0;
+        result.best = -1;
+        result.histogram.assign(2*n + 1, 0);
+        for (auto s : slots) {
+          result.runs += s->runs;
+          result.hits += s->hits;
+          for (int k = 0; k <= 2*n; k++) {
+            result.histogram[k] += s->histogram[k].load();
+          }
+          if (s->best > result.best) {
+            result.best = s->best;
+            result.best_x = s->best_x;
+            result.best_y = s->best_y;
+          }
+        }
+        result.seconds = omp_get_wtime() - n_start;
+        result.expired = expired.load();
+        {
+          std::lock_guard<std::mutex> solutions_guard(solutions_lock);
+          result.solutions.assign(solutions.begin(), solutions.end());
+
+          // An n cut short by the time budget stays current, so that a resume completes it
+          if (!result.expired) {
+            solutions.clear();
+            current_n = n + 1;
+            n_start = omp_get_wtime();
+          }
+        }
+
+        print_result(out, result, options.format, results.empty());
+        results.push_back(result);
+
+        delete base;
+        base = NULL;
+      }
+    }
+  }
+
+  done = true;
+  if (watchdog.joinable()) {
+    watchdog.join();
+  }
+  if (writer.joinable()) {
+    writer.join();
+  }
+  if (reporter.joinable()) {
+    reporter.join();
+  }
+  bool saved = failed || options.checkpoint.empty() || write_checkpoint();
+
+  delete base;
+  return !failed && saved && invalid.load() == 0;
+}
+
+/**
+ * Writes results to a binary results file, tagged with the signature and the seed and shard of options.
+ *   Integers are stored little-endian, so files can be merged on any machine.
+ */
+bool NTIAL_CAMPAIGN::save_results(const string &path, const Options &options, const string &signature,
+                                  const vector<Result> &results) {
+  std::ofstream out (path, std::ios::binary);
+  out.write(RESULTS_MAGIC, 8);
+  put_bytes(out, RESULTS_VERSION, 4);
+  put_bytes(out, signature.size(), 4);
+  out.write(signature.data(), signature.size());
+  put_bytes(out, options.seed, 8);
+  put_bytes(out, options.shard_index, 4);
+  put_bytes(out, options.shard_count, 4);
+  put_bytes(out, results.size(), 4);
+
+  for (auto &r : results) {
+    uint64_t seconds;
+    memcpy(&seconds, &r.seconds, sizeof(seconds));
+    put_bytes(out, r.n, 4);
+    put_bytes(out, r.runs, 8);
+    put_bytes(out, r.hits, 8);
+    put_bytes(out, (uint32_t)r.best, 4);
+    put_bytes(out, seconds, 8);
+    put_bytes(out, r.expired, 1);
+    put_bytes(out, r.histogram.size(), 4);
+    for (auto count : r.histogram) {
+      put_bytes(out, count, 8);
+    }
+    put_bytes(out, r.best_x.size(), 4);
+    for (size_t k = 0; k < r.best_x.size(); k++) {
+      put_bytes(out, r.best_x[k], 4);
+      put_bytes(out, r.best_y[k], 4);
+    }
+    put_bytes(out, r.solutions.size(), 8);
+    for (auto &cells : r.solutions) {
+      for (auto cell : cells) {
+        put_bytes(out, cell, 4);
+      }
+    }
+  }
+
+  out.close();
+  if (!out) {
+    std::cerr << path << ": cannot write results" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Reads a binary results file, setting the seed and shard of options and the signature
+ *   from its tag. Returns false if it cannot be read.
+ */
+bool NTIAL_CAMPAIGN::load_results(const string &path, Options &options, string &signature,
+                                  vector<Result> &results) {
+  std::ifstream in (path, std::ios::binary);
+  char magic[8] = {0};
+  in.read(magic, 8);
+  if (!in) {
+    std::cerr << path << ": cannot read results" << std::endl;
+    return false;
+  }
+  if (memcmp(magic, RESULTS_MAGIC, 8) != 0 || get_bytes(in, 4) != RESULTS_VERSION) {
+    std::cerr << path << ": not a results file of version " << RESULTS_VERSION << std::endl;
+    return false;
+  }
+  size_t sig_size = get_bytes(in, 4);
+  if (!in || sig_size > 4096) {
+    std::cerr << path << ": malformed results" << std::endl;
+    return false;
+  }
+  signature.resize(sig_size);
+  in.read(&signature[0], sig_size);
+  options.seed = get_bytes(in, 8);
+  options.shard_index = get_bytes(in, 4);
+  options.shard_count = get_bytes(in, 4);
+
+  // Sizes are checked before they are trusted with an allocation: every result takes at least
+  //   RESULT_MIN_BYTES, and every solution 8 bytes per point
+  uint64_t count = get_bytes(in, 4);
+  if (!in || count > remaining_bytes(in) / RESULT_MIN_BYTES) {
+    std::cerr << path << ": malformed results" << std::endl;
+    return false;
+  }
+  results.resize(count);
+  for (auto &r : results) {
+    uint64_t seconds;
+    r.n = get_bytes(in, 4);
+    r.runs = get_bytes(in, 8);
+    r.hits = get_bytes(in, 8);
+    r.best = (int32_t)get_bytes(in, 4);
+    seconds = get_bytes(in, 8);
+    memcpy(&r.seconds, &seconds, sizeof(seconds));
+    r.expired = get_bytes(in, 1);
+
+    size_t size = get_bytes(in, 4);
+    if (!in || r.n < 2 || r.n > (1 << 15) || size != (size_t)(2*r.n + 1)) {
+      in.setstate(std::ios::failbit);
+      break;
+    }
+    r.histogram.resize(size);
+    for (auto &count : r.histogram) {
+      count = get_bytes(in, 8);
+    }
+    size = get_bytes(in, 4);
+    if (!in || size > (size_t)(2*r.n)) {
+      in.setstate(std::ios::failbit);
+      break;
+    }
+    r.best_x.resize(size);
+    r.best_y.resize(size);
+    for (size_t k = 0; k < size; k++) {
+      r.best_x[k] = get_bytes(in, 4);
+      r.best_y[k] = get_bytes(in, 4);
+    }
+    size = get_bytes(in, 8);
+    if (!in || size > (size_t)r.hits || size > remaining_bytes(in) / (8*r.n)) {
+      in.setstate(std::ios::failbit);
+      break;
+    }
+    r.solutions.resize(size);
+    for (auto &cells : r.solutions) {
+      cells.resize(2*r.n);
+      for (auto &cell : cells) {
+        cell = get_bytes(in, 4);
+      }
+    }
+  }
+
+  if (!in) {
+    std::cerr << path << ": malformed results" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Adds other, a result for the same n from another shard, to result.
+ *   Solutions found by both shards are kept once.
+ */
+void NTIAL_CAMPAIGN::merge_result(Result &result, const Result &other) {
+  result.runs += other.runs;
+  result.hits += other.hits;
+  for (size_t k = 0; k < result.histogram.size(); k++) {
+    result.histogram[k] += other.histogram[k];
+  }
+  if (other.best > result.best) {
+    result.best = other.best;
+    result.best_x = other.best_x;
+    result.best_y = other.best_y;
+  }
+
+  // Shards run side by side, so the slowest one sets the time
+  result.seconds = std::max(result.seconds, other.seconds);
+  result.expired = result.expired || other.expired;
+
+  result.solutions.insert(result.solutions.end(), other.solutions.begin(), other.solutions.end());
+  std::sort(result.solutions.begin(), result.solutions.end());
+  result.solutions.erase(std::unique(result.solutions.begin(), result.solutions.end()), result.solutions.end());
+}
+
+/**
+ * Prints a result in the given format. The csv format prints a header with the first result.
+ */
+void NTIAL_CAMPAIGN::print_result(std::ostream &out, const Result &result, const string &format, bool first) {
+  size_t k;
+
+  if (format == "csv") {
+    if (first) {
+      out << "n,runs,best,hits,distinct,seconds,expired,best_points" << std::endl;
+    }
+    out << result.n << ',' << result.runs << ',' << result.best << ',' << result.hits << ','
+        << result.solutions.size() << ',' << result.seconds << ',' << result.expired << ',';
+    for (k = 0; k < result.best_x.size(); k++) {
+      out << (k ? ";" : "") << result.best_x[k] << ' ' << result.best_y[k];
+    }
+    out << std::endl;
+  } else if (format == "json") {
+    out << "{\"n\":" << result.n << ",\"runs\":" << result.runs << ",\"best\":" << result.best
+        << ",\"hits\":" << result.hits << ",\"distinct\":" << result.solutions.size() << ",\"seconds\":" << result.seconds
+        << ",\"expired\":" << (result.expired ? "true" : "false") << ",\"histogram\":[";
+    for (k = 0; k < result.histogram.size(); k++) {
+      out << (k ? "," : "") << result.histogram[k];
+    }
+    out << "],\"best_points\":[";
+    for (k = 0; k < result.best_x.size(); k++) {
+      out << (k ? "," : "") << '[' << result.best_x[k] << ',' << result.best_y[k] << ']';
+    }
+    out << "]}" << std::endl;
+  } else {
+    out << "n: " << result.n << ", runs: " << result.runs << ", best: " << result.best
+        << ", hits at 2n: " << result.hits << " (" << result.solutions.size() << " distinct), seconds: " << result.seconds
+        << (result.expired ? " (time budget expired)" : "") << std::endl;
+    print_points(out, result.n, result.best_x, result.best_y);
+  }
+}
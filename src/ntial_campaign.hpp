@@ -0,0 +1,210 @@
+#ifndef NTIAL_CAMPAIGN_H
+#define NTIAL_CAMPAIGN_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include "ntial_tt.hpp"
+
+/**
+ * A campaign of random solves over a range of problem sizes, run by one team of threads.
+ *   Per-n setup (warm start state, Zobrist keys, the shared prefix table) is built once per n
+ *   and every thread keeps its solver across runs, resetting it instead of reconstructing it.
+ *   With a time budget, a watchdog thread stops solves mid-run when it expires; the best
+ *   solution found so far is kept lock-free and reported.
+ *
+ *   Each thread rekeys its solver's generator before every call by (seed, n and thread,
+ *   call count), so the call count is its position in the random stream. Distinct keys give
+ *   distinct 256-bit generator states, so no two calls replay the same run. A background
+ *   thread periodically writes these positions, the statistics and the distinct solutions
+ *   found so far to a checkpoint file, from which a killed campaign resumes.
+ *
+ *   A campaign can be split across processes as shards k/N: thread t of shard k draws from
+ *   stream k + N*t. Stream indices never coincide between shards, and since the stream is
+ *   part of every run's key, neither do their runs. A run limit is divided between the
+ *   shards. Each shard saves its results to a binary file tagged with the campaign's
+ *   signature, and merge_result() combines results of the same signature.
+ *
+ *   For monitoring, a telemetry thread appends a JSON line of progress to a file or Unix
+ *   socket every few seconds, reading the per-thread counters without locks.
+ */
+class NTIAL_CAMPAIGN {
+
+  public:
+
+    /**
+     * Settings of a campaign
+     */
+    class Options {
+      public:
+        /**
+         * Constructs the default settings
+         */
+        Options();
+
+        int n_min;              // smallest problem size of the sweep
+        int n_max;              // largest problem size of the sweep
+        std::string solver;     // "rand", "dr", "symm", "fixed" or "batch"
+        bool symm;              // whether solutions must be diagonally symmetric
+        bool propagate;         // whether forced moves are propagated ("rand" only)
+        int tt_depth;           // picks recorded in the shared prefix table, 0 for none ("rand" only)
+        std::string warm_start; // file of pre-chosen points, empty for none ("rand" only)
+        int threads;            // number of threads, 0 for the OpenMP default
+        uint64_t seed;          // base seed of every thread's generator
+        long runs;              // runs per n, 0 for no limit
+        bool until_maximal;     // whether to stop each n at the first solution with 2n points
+        double time_budget;     // seconds after which the whole campaign stops, 0 for no limit
+        bool cpu_time;          // whether time_budget counts process CPU time instead of wall-clock time
+        std::string format;     // "text", "csv" or "json"
+        std::string checkpoint; // checkpoint file, empty for none
+        double checkpoint_interval; // seconds between checkpoints
+        bool resume;            // whether to continue from the checkpoint file if it exists
+        int shard_index;        // index k of this process's shard, 0 <= k < shard_count
+        int shard_count;        // number N of shards the campaign is split into
+        bool validate;          // whether every new best and 2n solution is checked by NTIAL_VALIDATE
+        std::string telemetry;  // file or Unix socket receiving JSON lines of progress, empty for none
+        double telemetry_interval; // seconds between telemetry lines
+    };
+
+    /**
+     * Statistics of the campaign for one problem size
+     */
+    class Result {
+      public:
+        int n;                    // the problem size
+        long runs;                // number of completed runs
+        long hits;                // number of runs that chose 2n points
+        int best;                 // largest number of points chosen
+        std::vector<long> histogram; // number of runs by number of points chosen
+        std::vector<int> best_x;  // x-coordinates of the best solution
+        std::vector<int> best_y;  // y-coordinates of the best solution
+        double seconds;           // wall-clock time spent on this n
+        bool expired;             // whether the time budget ran out during this n
+        std::vector<std::vector<int> > solutions; // distinct 2n solutions, as sorted cells x*n+y
+    };
+
+    /**
+     * Constructs a campaign. The options must pass check().
+     */
+    explicit NTIAL_CAMPAIGN(const Options &options);
+
+    /**
+     * Destroys a campaign
+     */
+    ~NTIAL_CAMPAIGN();
+
+    /**
+     * Checks that options are consistent. Returns false with a message in error otherwise.
+     */
+    static bool check(const Options &options, std::string &error);
+
+    /**
+     * Runs the sweep, printing each result to out as soon as its n is done.
+     *   Returns false if the checkpoint or warm start file could not be applied,
+     *   or if validation rejected a solution.
+     */
+    bool run(std::ostream &out);
+
+    /**
+     * Returns the results of the sweep so far, including those restored from a checkpoint
+     */
+    const std::vector<Result>& get_results();
+
+    /**
+     * Returns the settings of the campaign, with the seed and thread count of a resumed checkpoint
+     */
+    const Options& get_options();
+
+    /**
+     * Returns the settings that every shard of a campaign shares, as a line of "key value" pairs.
+     *   The seed, shard, thread count, time budget and output format are left out.
+     */
+    static std::string signature(const Options &options);
+
+    /**
+     * Writes results to a binary results file, tagged with the signature and the seed and shard of options
+     */
+    static bool save_results(const std::string &path, const Options &options, const std::string &signature,
+                             const std::vector<Result> &results);
+
+    /**
+     * Reads a binary results file, setting the seed and shard of options and the signature
+     *   from its tag. Returns false if it cannot be read.
+     */
+    static bool load_results(const std::string &path, Options &options, std::string &signature,
+                             std::vector<Result> &results);
+
+    /**
+     * Adds other, a result for the same n from another shard, to result.
+     *   Solutions found by both shards are kept once.
+     */
+    static void merge_result(Result &result, const Result &other);
+
+    /**
+     * Prints a result in the given format. The csv format prints a header with the first result.
+     */
+    static void print_result(std::ostream &out, const Result &result, const std::string &format, bool first);
+
+  private:
+
+    class Slot;
+
+    NTIAL_CAMPAIGN(const NTIAL_CAMPAIGN &);
+    NTIAL_CAMPAIGN& operator=(const NTIAL_CAMPAIGN &);
+
+    /**
+     * Returns the settings a resumed campaign must share with its checkpoint
+     */
+    std::string checkpoint_signature();
+
+    /**
+     * Returns the time budget used so far, including time used before a resume
+     */
+    double budget_used();
+
+    /**
+     * Writes the checkpoint file, replacing the previous one atomically
+     */
+    bool write_checkpoint();
+
+    /**
+     * Restores the campaign from the checkpoint file, if it exists.
+     *   Returns false if it exists but cannot be used.
+     */
+    bool load_checkpoint();
+
+    /**
+     * Rewrites the checkpoint every checkpoint_interval seconds until the sweep is done
+     */
+    void checkpoint_loop();
+
+    /**
+     * Sends a line of progress to the telemetry sink every telemetry_interval seconds,
+     *   and a last one when the sweep is done
+     */
+    void telemetry_loop();
+
+    Options options;              // settings of the campaign
+    int threads;                  // number of threads in the team
+    NTIAL_TT* tt;                 // prefix table reused by every n (may be NULL)
+    std::vector<Result> results;  // results of the sweep so far
+
+    // State shared with the checkpoint writer
+    std::mutex state_lock;        // guards results, current_n and n_start
+    int current_n;                // the problem size in progress, n_max + 1 once done
+    double n_start;               // wall-clock time at which current_n started, less time before a resume
+    double budget_before;         // time budget used before a resume
+    double budget_start;          // wall-clock or CPU time at which this process started
+    std::vector<Slot*> slots;     // per-thread statistics for current_n
+    std::mutex solutions_lock;    // guards solutions
+    std::set<std::vector<int> > solutions; // distinct 2n solutions of current_n
+    std::atomic<long> distinct;   // size of solutions, readable without solutions_lock
+    double started;               // wall-clock time at which run() started
+    std::atomic<bool> done;       // set once the sweep has finished
+};
+
+#endif /* NTIAL_CAMPAIGN_H */
@@ -0,0 +1,159 @@
+#include "ntial_dispatch.hpp"
+#include "ntial_fixed.hpp"
+#include "ntial_rand.hpp"
+
+// Sizes with a compile-time specialization
+#define NTIAL_FIXED_SIZES(X) \
+  X(3)  X(4)  X(5)  X(6)  X(7)  X(8)  X(9)  X(10) X(11) X(12) \
+  X(13) X(14) X(15) X(16) X(17) X(18) X(19) X(20) X(21) X(22) \
+  X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31) X(32)
+
+/**
+ * The interface shared by specialized and dynamic solvers
+ */
+class NTIAL_DISPATCH::Engine {
+  public:
+    virtual ~Engine() {}
+    virtual void print_grid() = 0;
+    virtual int get_chosen() = 0;
+    virtual void get_point(int k, int &x, int &y) = 0;
+    virtual void reset() = 0;
+    virtual void seed(uint64_t s, uint64_t stream, uint64_t call) = 0;
+    virtual void set_stop_flag(const std::atomic<bool>* flag) = 0;
+    virtual bool was_interrupted() = 0;
+    virtual int solve() = 0;
+    virtual int solve_diag_symm() = 0;
+};
+
+/**
+ * Adapts a solver class to the Engine interface
+ */
+template <class Solver>
+class EngineAdapter : public NTIAL_DISPATCH::Engine {
+  public:
+    template <class... Args>
+    explicit EngineAdapter(Args... args) : prob(args...) {}
+
+    void print_grid() { prob.print_grid(); }
+    int get_chosen() { return prob.get_chosen(); }
+    void get_point(int k, int &x, int &y) { prob.get_point(k, x, y); }
+    void reset() { prob.reset(); }
+    void seed(uint64_t s, uint64_t stream, uint64_t call) { prob.seed(s, stream, call); }
+    void set_stop_flag(const std::atomic<bool>* flag) { prob.set_stop_flag(flag); }
+    bool was_interrupted() { return prob.was_interrupted(); }
+    int solve() { return prob.solve(); }
+    int solve_diag_symm() { return prob.solve_diag_symm(); }
+
+  private:
+    Solver prob;
+};
+
+
+/***************************
+ * NTIAL_DISPATCH member definitions *
+ ****************************/
+/**
+ * Constructs a solver for the n*n problem
+ */
+NTIAL_DISPATCH::NTIAL_DISPATCH(int n) {
+  fixed = true;
+  switch (n) {
+#define NTIAL_FIXED_CASE(N) case N: engine = new EngineAdapter<NTIAL_FIXED<N> >(); break;
+    NTIAL_FIXED_SIZES(NTIAL_FIXED_CASE)
+#undef NTIAL_FIXED_CASE
+    default:
+      engine = new EngineAdapter<NTIAL_RAND>(n);
+      fixed = false;
+  }
+}
+
+/**
+ * Destroys the solver
+ */
+NTIAL_DISPATCH::~NTIAL_DISPATCH() {
+  delete engine;
+}
+
+/**
+ * Checks whether a specialization for n is built
+ */
+bool NTIAL_DISPATCH::has_specialization(int n) {
+  switch (n) {
+#define NTIAL_FIXED_CASE(N) case N:
+    NTIAL_FIXED_SIZES(NTIAL_FIXED_CASE)
+#undef NTIAL_FIXED_CASE
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Checks whether this solver uses a specialization
+ */
+bool NTIAL_DISPATCH::specialized() {
+  return fixed;
+}
+
+/**
+ * Prints current state of the grid to stdout. '*' indicates chosen points.
+ */
+void NTIAL_DISPATCH::print_grid() {
+  engine->print_grid();
+}
+
+/**
+ * Returns the number of points chosen
+ */
+int NTIAL_DISPATCH::get_chosen() {
+  return engine->get_chosen();
+}
+
+/**
+ * Returns the coordinates of the k-th chosen point
+ */
+void NTIAL_DISPATCH::get_point(int k, int &x, int &y) {
+  engine->get_point(k, x, y);
+}
+
+/**
+ * Resets the problem
+ */
+void NTIAL_DISPATCH::reset() {
+  engine->reset();
+}
+
+/**
+ * Reseeds the random number generator, keyed by (s, stream, call)
+ */
+void NTIAL_DISPATCH::seed(uint64_t s, uint64_t stream, uint64_t call) {
+  engine->seed(s, stream, call);
+}
+
+/**
+ * Shares a flag that makes solves return early once it is set.
+ */
+void NTIAL_DISPATCH::set_stop_flag(const std::atomic<bool>* flag) {
+  engine->set_stop_flag(flag);
+}
+
+/**
+ * Checks whether the stop flag cut the last solve short, leaving points available
+ */
+bool NTIAL_DISPATCH::was_interrupted() {
+  return engine->was_interrupted();
+}
+
+/**
+ * Attempts to find a maximal solution. Returns number of points chosen
+ */
+int NTIAL_DISPATCH::solve() {
+  return engine->solve();
+}
+
+/**
+ * Attempts to find a maximal diagonally symmetric solution. Returns number of points chosen
+ */
+int NTIAL_DISPATCH::solve_diag_symm() {
+  return engine->solve_diag_symm();
+}
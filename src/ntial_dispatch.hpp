@@ -0,0 +1,92 @@
+#ifndef NTIAL_DISPATCH_H
+#define NTIAL_DISPATCH_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A random No-Three-In-A-Line solver that uses a compile-time specialized NTIAL_FIXED<n>
+ *   when one is built for n, and falls back to the dynamic NTIAL_RAND otherwise.
+ */
+class NTIAL_DISPATCH {
+
+  public:
+
+    /**
+     * Constructs a solver for the n*n problem
+     */
+    explicit NTIAL_DISPATCH(int n);
+
+    /**
+     * Destroys the solver
+     */
+    ~NTIAL_DISPATCH();
+
+    /**
+     * Checks whether a specialization for n is built
+     */
+    static bool has_specialization(int n);
+
+    /**
+     * Checks whether this solver uses a specialization
+     */
+    bool specialized();
+
+    /**
+     * Prints current state of the grid to stdout. '*' indicates chosen points.
+     */
+    void print_grid();
+
+    /**
+     * Returns the number of points chosen
+     */
+    int get_chosen();
+
+    /**
+     * Returns the coordinates of the k-th chosen point
+     */
+    void get_point(int k, int &x, int &y);
+
+    /**
+     * Resets the problem
+     */
+    void reset();
+
+    /**
+     * Reseeds the random number generator, keyed by (s, stream, call)
+     */
+    void seed(uint64_t s, uint64_t stream = 0, uint64_t call = 0);
+
+    /**
+     * Shares a flag that makes solves return early, before the solution is maximal, once it is set.
+     *   Passing NULL removes it.
+     */
+    void set_stop_flag(const std::atomic<bool>* flag);
+
+    /**
+     * Checks whether the stop flag cut the last solve short, leaving points available
+     */
+    bool was_interrupted();
+
+    /**
+     * Attempts to find a maximal solution. Returns number of points chosen
+     */
+    int solve();
+
+    /**
+     * Attempts to find a maximal diagonally symmetric solution. Returns number of points chosen
+     */
+    int solve_diag_symm();
+
+    class Engine;
+
+  private:
+
+    NTIAL_DISPATCH(const NTIAL_DISPATCH &);
+    NTIAL_DISPATCH& operator=(const NTIAL_DISPATCH &);
+
+    Engine* engine;         // the specialized or dynamic solver
+    bool fixed;             // whether engine is specialized
+};
+
+#endif /* NTIAL_DISPATCH_H */
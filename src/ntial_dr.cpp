@@ -38,21 +38,25 @@ bool NTIAL_DR::Point::PointCompare(Point* a, Point* b) {
  */
 NTIAL_DR::NTIAL_DR(int N) {
   n = N;
+  stop_flag = NULL;
+  interrupted = false;
 
   // Allocate memory
-  grid = (Point*)malloc(n*n*sizeof(Point));
+  grid = (Point*)calloc(GRID_CELLS(n), sizeof(Point));
 
   // Initialize data
   init_data();
 
   // Fill available array
-  for (Point *p = grid; p < grid + n*n; p++) {
-    available.push_back(p);
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i < n; i++) {
+      available.push_back(grid + IDX2(i, j, n));
+    }
   }
 
   // obtain a seed from the system clock
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  generator = std::default_random_engine (seed);
+  uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+  generator.seed(seed);
 }
 
 /**
@@ -136,6 +140,42 @@ void NTIAL_DR::print_chosen() {
   }
 }
 
+/**
+ * Returns the number of points chosen
+ */
+int NTIAL_DR::get_chosen() {
+  return chosen.size();
+}
+
+/**
+ * Returns the coordinates of the k-th chosen point
+ */
+void NTIAL_DR::get_point(int k, int &x, int &y) {
+  x = chosen[k]->x;
+  y = chosen[k]->y;
+}
+
+/**
+ * Reseeds the random number generator, keyed by (s, stream, call)
+ */
+void NTIAL_DR::seed(uint64_t s, uint64_t stream, uint64_t call) {
+  generator.seed(s, stream, call);
+}
+
+/**
+ * Shares a flag that makes solves return early once it is set.
+ */
+void NTIAL_DR::set_stop_flag(const std::atomic<bool>* flag) {
+  stop_flag = flag;
+}
+
+/**
+ * Checks whether the stop flag cut the last solve short, leaving points available
+ */
+bool NTIAL_DR::was_interrupted() {
+  return interrupted;
+}
+
 /**
  * FOR TESTING: returns the internal grid
  */
@@ -287,7 +327,7 @@ int NTIAL_DR::solve() {
 
   // Iterate until all points are unavailable
   Point *p;
-  while (available[0]->delete_rank < INT_MAX) {
+  while (available[0]->delete_rank < INT_MAX && !(stop_flag && stop_flag->load(std::memory_order_relaxed))) {
     p = choose_next();
     /* std::cout << "Iterating on point: " << *p << std::endl; */
     delete_invalid_points(p);
@@ -297,5 +337,6 @@ int NTIAL_DR::solve() {
     sort_available();
   }
 
+  interrupted = available[0]->delete_rank < INT_MAX;
   return chosen.size();
 }
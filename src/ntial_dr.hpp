@@ -3,8 +3,10 @@
 
 #include <vector>
 #include <random>
+#include <atomic>
 
-#define IDX2(i,j,i_stride) ((i)+(j*i_stride))
+#include "ntial_layout.hpp"
+#include "ntial_random.hpp"
 
 /**
  * An instance of the No-Three-In-A-Line problem
@@ -61,6 +63,21 @@ class NTIAL_DR {
      */
     void print_chosen();
 
+    /**
+     * Returns the number of points chosen
+     */
+    int get_chosen();
+
+    /**
+     * Returns the coordinates of the k-th chosen point
+     */
+    void get_point(int k, int &x, int &y);
+
+    /**
+     * Reseeds the random number generator, keyed by (s, stream, call)
+     */
+    void seed(uint64_t s, uint64_t stream = 0, uint64_t call = 0);
+
     /**
      * FOR TESTING: retruns the internal grid
      */
@@ -89,6 +106,17 @@ class NTIAL_DR {
      */
     int solve();
 
+    /**
+     * Shares a flag that makes solves return early, before the solution is maximal, once it is set.
+     *   Passing NULL removes it.
+     */
+    void set_stop_flag(const std::atomic<bool>* flag);
+
+    /**
+     * Checks whether the stop flag cut the last solve short, leaving points available
+     */
+    bool was_interrupted();
+
     /**
      * Resets an instantiated NTIAL_DR problem.
      */
@@ -122,10 +150,12 @@ class NTIAL_DR {
     inline bool in_grid(int x, int y);
 
     int n;                                // The size of the No-Three-In-A-Line problem
-    Point* grid;                          // an n*n grid of Points
+    Point* grid;                          // an n*n grid of Points, laid out by IDX2
     std::vector<Point*> available;        // a list of the available points
     std::vector<Point*> chosen;           // a list of the chosen points
-    std::default_random_engine generator; // the random number generator
+    NTIAL_ENGINE generator;               // the random number generator
+    const std::atomic<bool>* stop_flag;   // when set, solves return early (may be NULL)
+    bool interrupted;                     // whether the stop flag cut the last solve short
 };
 
 #endif /* NTIAL_DR_H */
@@ -0,0 +1,274 @@
+#ifndef NTIAL_FIXED_H
+#define NTIAL_FIXED_H
+
+#include <iostream>
+#include <string>
+#include <array>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include "ntial_random.hpp"
+
+/**
+ * An instance of the No-Three-In-A-Line problem with the size N fixed at compile time, for N <= 64.
+ *   Rows are 64-bit bitboards, bounds are checked against the constant N, and the primitive step
+ *   between any two grid points comes from a constexpr table instead of a gcd.
+ */
+template <int N>
+class NTIAL_FIXED {
+
+  static_assert(2 <= N && N <= 64, "NTIAL_FIXED holds one 64-bit word per row");
+
+  public:
+
+    /**
+     * Constructs an instance of the No-Three-In-A-Line problem
+     */
+    NTIAL_FIXED() {
+      stop_flag = NULL;
+      interrupted = false;
+      reset();
+
+      // obtain a seed from the system clock
+      uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+      generator.seed(seed);
+    }
+
+    /**
+     * Prints current state of the grid to stdout. '*' indicates chosen points.
+     */
+    void print_grid() {
+      std::array<std::string, N> rows;
+      rows.fill(std::string(N, ' '));
+      for (int k = 0; k < num_chosen; k++) {
+        rows[chosen_x[k]][chosen_y[k]] = '*';
+      }
+
+      std::string border (N+2, '-');
+      std::cout << border << std::endl;
+      for (auto &row : rows) {
+        std::cout << '|' << row << '|' << std::endl;
+      }
+      std::cout << border << std::endl;
+    }
+
+    /**
+     * Returns the number of points chosen
+     */
+    int get_chosen() {
+      return num_chosen;
+    }
+
+    /**
+     * Returns the coordinates of the k-th chosen point
+     */
+    void get_point(int k, int &x, int &y) {
+      x = chosen_x[k];
+      y = chosen_y[k];
+    }
+
+    /**
+     * Resets an instantiated NTIAL_FIXED problem.
+     */
+    void reset() {
+      avail.fill(FULL_ROW);
+      num_chosen = 0;
+    }
+
+    /**
+     * Reseeds the random number generator, keyed by (s, stream, call)
+     */
+    void seed(uint64_t s, uint64_t stream = 0, uint64_t call = 0) {
+      generator.seed(s, stream, call);
+    }
+
+    /**
+     * Shares a flag that makes solves return early, before the solution is maximal, once it is set.
+     *   Passing NULL removes it.
+     */
+    void set_stop_flag(const std::atomic<bool>* flag) {
+      stop_flag = flag;
+    }
+
+    /**
+     * Checks whether the stop flag cut the last solve short, leaving points available
+     */
+    bool was_interrupted() {
+      return interrupted;
+    }
+
+    /**
+     * Attempts to find a maximal solution for the N*N No-Three-In-A-Line problem
+     *   Returns number of points chosen
+     */
+    int solve() {
+      int x, y;
+      interrupted = false;
+      while (choose_next(x, y)) {
+        if (stopped()) {
+          interrupted = true;
+          break;
+        }
+        process_point(x, y);
+      }
+      return num_chosen;
+    }
+
+    /**
+     * Attempts to find a maximal diagonally symmetric solution for the N*N No-Three-In-A-Line problem
+     *   Returns number of points chosen
+     */
+    int solve_diag_symm() {
+      int x, y;
+      interrupted = false;
+      while (choose_next(x, y)) {
+        if (stopped()) {
+          interrupted = true;
+          break;
+        }
+        process_point(x, y);
+        if (x == y) {
+          delete_line(x, y, 1, -1);
+        } else {
+          process_point(y, x);
+        }
+      }
+      return num_chosen;
+    }
+
+  private:
+
+    static constexpr uint64_t FULL_ROW = (N == 64) ? ~0ull : (1ull << N) - 1;
+
+    /**
+     * The primitive step (run, rise) for every offset (dx, dy) between two grid points
+     */
+    struct Directions {
+      int8_t step[2*N-1][2*N-1][2];
+
+      constexpr Directions() : step{} {
+        for (int dx = 1 - N; dx < N; dx++) {
+          for (int dy = 1 - N; dy < N; dy++) {
+            int a = dx < 0 ? -dx : dx;
+            int b = dy < 0 ? -dy : dy;
+            while (b != 0) {
+              int t = a % b;
+              a = b;
+              b = t;
+            }
+            if (a == 0) {
+              a = 1;
+            }
+            step[dx+N-1][dy+N-1][0] = dx / a;
+            step[dx+N-1][dy+N-1][1] = dy / a;
+          }
+        }
+      }
+    };
+
+    static constexpr Directions directions {};
+
+    /**
+     * Checks whether the point (x, y) is in the grid
+     */
+    static constexpr bool in_grid(int x, int y) {
+      return (unsigned)x < (unsigned)N && (unsigned)y < (unsigned)N;
+    }
+
+    /**
+     * Checks whether the stop flag is set
+     */
+    bool stopped() {
+      return stop_flag && stop_flag->load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Picks a uniformly random available point. Returns false if there is none.
+     */
+    bool choose_next(int &x, int &y) {
+      int count = 0;
+      for (int i = 0; i < N; i++) {
+        count += __builtin_popcountll(avail[i]);
+      }
+      if (count == 0) {
+        return false;
+      }
+
+      std::uniform_int_distribution<int> distribution(0, count - 1);
+      int r = distribution(generator);
+
+      // Find the row holding the r-th available point, then the point itself
+      uint64_t row;
+      for (x = 0; ; x++) {
+        row = avail[x];
+        int row_count = __builtin_popcountll(row);
+        if (r < row_count) {
+          break;
+        }
+        r -= row_count;
+      }
+      while (r--) {
+        row &= row - 1;
+      }
+      y = __builtin_ctzll(row);
+      return true;
+    }
+
+    /**
+     * Deletes point along line through (x0, y0) with given slope
+     */
+    void delete_line(int x0, int y0, int rise, int run) {
+      if (run == 0) {
+        avail[x0] = 0;
+        return;
+      }
+
+      int x, y;
+      x = x0 + run;
+      y = y0 + rise;
+      while (in_grid(x, y)) {
+        avail[x] &= ~(1ull << y);
+        x += run;
+        y += rise;
+      }
+      x = x0 - run;
+      y = y0 - rise;
+      while (in_grid(x, y)) {
+        avail[x] &= ~(1ull << y);
+        x -= run;
+        y -= rise;
+      }
+    }
+
+    /**
+     * Chooses (x, y) and deletes the points that became invalid
+     */
+    void process_point(int x, int y) {
+      for (int k = 0; k < num_chosen; k++) {
+        const int8_t *step = directions.step[x - chosen_x[k] + N - 1][y - chosen_y[k] + N - 1];
+        delete_line(x, y, step[1], step[0]);
+      }
+
+      chosen_x[num_chosen] = x;
+      chosen_y[num_chosen] = y;
+      num_chosen++;
+      avail[x] &= ~(1ull << y);
+    }
+
+    std::array<uint64_t, N> avail;          // avail[x] has bit y set if (x, y) is available
+    std::array<uint8_t, 2*N> chosen_x;      // x-coordinates of the chosen points
+    std::array<uint8_t, 2*N> chosen_y;      // y-coordinates of the chosen points
+    int num_chosen;                         // number of points chosen
+    NTIAL_ENGINE generator;                 // the random number generator
+    const std::atomic<bool>* stop_flag;     // when set, solves return early (may be NULL)
+    bool interrupted;                       // whether the stop flag cut the last solve short
+};
+
+template <int N>
+constexpr uint64_t NTIAL_FIXED<N>::FULL_ROW;
+
+template <int N>
+constexpr typename NTIAL_FIXED<N>::Directions NTIAL_FIXED<N>::directions;
+
+#endif /* NTIAL_FIXED_H */
@@ -0,0 +1,95 @@
+#ifndef NTIAL_LAYOUT_H
+#define NTIAL_LAYOUT_H
+
+#include <cstddef>
+
+/**
+ * Memory layout of the n*n grids of NTIAL_RAND and NTIAL_DR, selected at compile time:
+ *   (default)            flat column-major: (i, j) is at i + j*n
+ *   NTIAL_LAYOUT_TILED   TILE_SIDE*TILE_SIDE tiles, column-major within and between tiles
+ *   NTIAL_LAYOUT_MORTON  Z-order curve over the grid padded to a power-of-two side
+ * IDX2 returns the offset of (i, j) and GRID_CELLS the number of cells to allocate,
+ *   which exceeds n*n when the layout pads the grid.
+ */
+
+#if defined(NTIAL_LAYOUT_TILED)
+
+// Side of a tile. A power of two.
+#define TILE_SIDE 8
+
+/**
+ * Returns the number of tiles along one side of an n*n grid
+ */
+inline size_t grid_tiles(int n) {
+  return (n + TILE_SIDE - 1) / TILE_SIDE;
+}
+
+/**
+ * Returns the offset of (i, j) in a tiled n*n grid
+ */
+inline size_t grid_offset(int i, int j, int n) {
+  size_t tile = (j / TILE_SIDE) * grid_tiles(n) + (i / TILE_SIDE);
+  return tile * TILE_SIDE * TILE_SIDE + (j % TILE_SIDE) * TILE_SIDE + (i % TILE_SIDE);
+}
+
+/**
+ * Returns the number of cells in a tiled n*n grid
+ */
+inline size_t grid_cells(int n) {
+  return grid_tiles(n) * grid_tiles(n) * TILE_SIDE * TILE_SIDE;
+}
+
+#elif defined(NTIAL_LAYOUT_MORTON)
+
+/**
+ * Spreads the low 16 bits of v over the even bits of the result
+ */
+inline size_t morton_spread(size_t v) {
+  v &= 0xFFFF;
+  v = (v | (v << 8)) & 0x00FF00FF;
+  v = (v | (v << 4)) & 0x0F0F0F0F;
+  v = (v | (v << 2)) & 0x33333333;
+  v = (v | (v << 1)) & 0x55555555;
+  return v;
+}
+
+/**
+ * Returns the offset of (i, j) in a Morton-ordered grid
+ */
+inline size_t grid_offset(int i, int j, int) {
+  return morton_spread(i) | (morton_spread(j) << 1);
+}
+
+/**
+ * Returns the number of cells in a Morton-ordered n*n grid
+ */
+inline size_t grid_cells(int n) {
+  size_t side = 1;
+  while (side < (size_t)n) {
+    side <<= 1;
+  }
+  return side * side;
+}
+
+#else
+
+/**
+ * Returns the offset of (i, j) in a flat n*n grid
+ */
+inline size_t grid_offset(int i, int j, int n) {
+  return i + (size_t)j * n;
+}
+
+/**
+ * Returns the number of cells in a flat n*n grid
+ */
+inline size_t grid_cells(int n) {
+  return (size_t)n * n;
+}
+
+#endif
+
+#define IDX2(i,j,i_stride) grid_offset((i), (j), (i_stride))
+#define GRID_CELLS(n) grid_cells(n)
+
+#endif /* NTIAL_LAYOUT_H */
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -6,11 +8,15 @@
 #include <random>
 #include <chrono>
 #include <limits.h>
+#include <string.h>
 #include "ntial_rand.hpp"
 
 using std::vector;
 using std::string;
 
+// Number of times a candidate leading to a dead prefix is resampled
+#define TT_RETRIES 4
+
 /****************************
  * Point member definitions *
  ****************************/
@@ -31,16 +37,85 @@ std::ostream& operator<<(std::ostream &output, const NTIAL_RAND::Point &p) {
  */
 NTIAL_RAND::NTIAL_RAND(int N) {
   n = N;
+  propagate = false;
+  tt = NULL;
+  tt_depth = 0;
+  warm_start = false;
+  stop_flag = NULL;
+  interrupted = false;
 
   // Allocate memory
-  grid = (Point*)malloc(n*n*sizeof(Point));
+  grid = (Point*)calloc(GRID_CELLS(n), sizeof(Point));
+  line_avail.resize(2*n);
+  line_chosen.resize(2*n);
+  queued.resize(2*n);
+
+  // Zobrist keys depend only on n, so hashes agree between solvers sharing a table
+  std::mt19937_64 key_gen (0x9E3779B97F4A7C15ull ^ n);
+  zobrist.resize(GRID_CELLS(n));
+  for (auto &key : zobrist) {
+    key = key_gen();
+  }
 
   // Initialize data
   init_data();
 
   // obtain a seed from the system clock
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  generator = std::default_random_engine (seed);
+  uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+  generator.seed(seed);
+}
+
+/**
+ * Clones an instance of the No-Three-In-A-Line problem, including its random number generator.
+ */
+NTIAL_RAND::NTIAL_RAND(const NTIAL_RAND &other) {
+  n = other.n;
+  grid = (Point*)calloc(GRID_CELLS(n), sizeof(Point));
+  *this = other;
+}
+
+/**
+ * Copies the state of another instance, resizing this one if the sizes differ
+ */
+NTIAL_RAND& NTIAL_RAND::operator=(const NTIAL_RAND &other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (other.n != n) {
+    free(grid);
+    n = other.n;
+    grid = (Point*)calloc(GRID_CELLS(n), sizeof(Point));
+  }
+  memcpy(grid, other.grid, GRID_CELLS(n)*sizeof(Point));
+
+  // Point references are rebased onto this grid
+  available.resize(other.available.size());
+  for (size_t i = 0; i < available.size(); i++) {
+    available[i] = grid + (other.available[i] - other.grid);
+  }
+  chosen.resize(other.chosen.size());
+  for (size_t i = 0; i < chosen.size(); i++) {
+    chosen[i] = grid + (other.chosen[i] - other.grid);
+  }
+
+  generator = other.generator;
+  propagate = other.propagate;
+  line_avail = other.line_avail;
+  line_chosen = other.line_chosen;
+  touched = other.touched;
+  queued = other.queued;
+  zobrist = other.zobrist;
+  hash = other.hash;
+  tt = other.tt;
+  tt_depth = other.tt_depth;
+  prefix = other.prefix;
+  warm_start = other.warm_start;
+  warm = other.warm;
+  stop_flag = other.stop_flag;
+  interrupted = other.interrupted;
+
+  return *this;
 }
 
 /**
@@ -67,16 +142,31 @@ void NTIAL_RAND::init_data() {
   }
   
   // Fill available array
-  for (Point *p = grid; p < grid + n*n; p++) {
-    available.push_back(p);
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i < n; i++) {
+      available.push_back(grid + IDX2(i, j, n));
+    }
   }
 
+  // Every row and column starts with n available points
+  std::fill(line_avail.begin(), line_avail.end(), n);
+  std::fill(line_chosen.begin(), line_chosen.end(), 0);
+  std::fill(queued.begin(), queued.end(), false);
+  touched.clear();
+
+  hash = 0;
+  prefix.clear();
 }
 
 /**
  * Resets an instantiated NTIAL_RAND problem.
  */
 void NTIAL_RAND::reset() {
+  if (warm_start) {
+    restore(warm);
+    return;
+  }
+
   // Clear data structures vector
   chosen.clear();
   available.clear();
@@ -85,6 +175,173 @@ void NTIAL_RAND::reset() {
   init_data();
 }
 
+/**
+ * Loads a warm start configuration and caches the resulting state for reset()
+ */
+bool NTIAL_RAND::load_seed(const std::string &path, bool symm) {
+  std::ifstream file (path);
+  if (!file) {
+    std::cerr << path << ": cannot open warm start file" << std::endl;
+    return false;
+  }
+
+  clear_seed();
+  reset();
+
+  string line;
+  int line_no = 0;
+  int x, y;
+  while (std::getline(file, line)) {
+    line_no++;
+    // Only blank lines and comments are skipped; any other line must be exactly two integers
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == string::npos || line[start] == '#') {
+      continue;
+    }
+    std::istringstream fields (line);
+    if (!(fields >> x >> y) || !(fields >> std::ws).eof()) {
+      std::cerr << path << ":" << line_no << ": expected \"x y\"" << std::endl;
+      reset();
+      return false;
+    }
+
+    // Mirror images may be listed explicitly in symmetric seeds
+    if (symm && in_grid(x, y) && grid[IDX2(x,y,n)].chosen) {
+      continue;
+    }
+    if (!add_point(x, y, symm)) {
+      std::cerr << path << ":" << line_no << ": (" << x << ", " << y
+                << ") is outside the grid or collinear with two earlier points" << std::endl;
+      reset();
+      return false;
+    }
+  }
+
+  // With propagation, apply the choices the seed forces and reject a seed that leaves
+  //   some row or column unable to hold two points
+  if (propagate) {
+    touch_all_lines();
+    bool consistent = propagate_forced(symm);
+    clear_unavailable();
+    if (!consistent) {
+      std::cerr << path << ": leaves a row or column unable to hold two points" << std::endl;
+      reset();
+      return false;
+    }
+  }
+
+  save(warm);
+  warm_start = true;
+  return true;
+}
+
+/**
+ * Drops the warm start configuration so that reset() returns to an empty grid
+ */
+void NTIAL_RAND::clear_seed() {
+  warm_start = false;
+}
+
+/**
+ * Reseeds the random number generator, keyed by (s, stream, call)
+ */
+void NTIAL_RAND::seed(uint64_t s, uint64_t stream, uint64_t call) {
+  generator.seed(s, stream, call);
+}
+
+/**
+ * Saves the current state. Must be called between picks.
+ */
+void NTIAL_RAND::save(Snapshot &snapshot) {
+  snapshot.n = n;
+  snapshot.grid.assign(grid, grid + GRID_CELLS(n));
+
+  snapshot.available.resize(available.size());
+  for (size_t i = 0; i < available.size(); i++) {
+    snapshot.available[i] = available[i] - grid;
+  }
+  snapshot.chosen.resize(chosen.size());
+  for (size_t i = 0; i < chosen.size(); i++) {
+    snapshot.chosen[i] = chosen[i] - grid;
+  }
+
+  snapshot.line_avail = line_avail;
+  snapshot.line_chosen = line_chosen;
+  snapshot.hash = hash;
+  snapshot.prefix = prefix;
+}
+
+/**
+ * Restores a state saved from an instance of the same size.
+ *   Returns false, leaving the state unchanged, if the snapshot is of another size.
+ */
+bool NTIAL_RAND::restore(const Snapshot &snapshot) {
+  if (snapshot.n != n || snapshot.grid.size() != GRID_CELLS(n)) {
+    return false;
+  }
+
+  memcpy(grid, snapshot.grid.data(), GRID_CELLS(n)*sizeof(Point));
+
+  available.resize(snapshot.available.size());
+  for (size_t i = 0; i < available.size(); i++) {
+    available[i] = grid + snapshot.available[i];
+  }
+  chosen.resize(snapshot.chosen.size());
+  for (size_t i = 0; i < chosen.size(); i++) {
+    chosen[i] = grid + snapshot.chosen[i];
+  }
+
+  line_avail = snapshot.line_avail;
+  line_chosen = snapshot.line_chosen;
+  hash = snapshot.hash;
+  prefix = snapshot.prefix;
+
+  // Snapshots are taken between picks, so nothing is pending, but a snapshot taken
+  //   without propagation may hold lines that are already forced or dead
+  std::fill(queued.begin(), queued.end(), false);
+  touched.clear();
+  if (propagate && !chosen.empty()) {
+    touch_all_lines();
+  }
+  return true;
+}
+
+/**
+ * Enables or disables forced-move propagation.
+ */
+void NTIAL_RAND::set_propagation(bool enable) {
+  propagate = enable;
+}
+
+/**
+ * Shares a transposition table of prefix outcomes with this solver.
+ */
+void NTIAL_RAND::set_transposition_table(NTIAL_TT* table, int depth) {
+  tt = table;
+  tt_depth = depth;
+}
+
+/**
+ * Shares a flag that makes solves return early once it is set.
+ */
+void NTIAL_RAND::set_stop_flag(const std::atomic<bool>* flag) {
+  stop_flag = flag;
+}
+
+/**
+ * Checks whether the stop flag cut the last solve short, leaving points available
+ */
+bool NTIAL_RAND::was_interrupted() {
+  return interrupted;
+}
+
+/**
+ * Returns the Zobrist hash of the chosen set
+ */
+uint64_t NTIAL_RAND::get_hash() {
+  return hash;
+}
+
 /**
  * Prints current state of the grid to stdout. '*' indicates chosen points.
  */
@@ -129,6 +386,21 @@ void NTIAL_RAND::print_chosen() {
   }
 }
 
+/**
+ * Returns the number of points chosen
+ */
+int NTIAL_RAND::get_chosen() {
+  return chosen.size();
+}
+
+/**
+ * Returns the coordinates of the k-th chosen point
+ */
+void NTIAL_RAND::get_point(int k, int &x, int &y) {
+  x = chosen[k]->x;
+  y = chosen[k]->y;
+}
+
 /**
  * FOR TESTING: returns the internal grid
  */
@@ -147,7 +419,15 @@ inline bool NTIAL_RAND::in_grid(int x, int y) {
  * Deletes the point p
  */
 inline void NTIAL_RAND::delete_point(Point * p) {
-  p->available = false;
+  if (p->available) {
+    p->available = false;
+    line_avail[p->x]--;
+    line_avail[n + p->y]--;
+    if (propagate) {
+      touch_line(p->x);
+      touch_line(n + p->y);
+    }
+  }
 }
 
 /**
@@ -156,15 +436,126 @@ inline void NTIAL_RAND::delete_point(Point * p) {
 inline void NTIAL_RAND::choose_point(Point * p) {
   chosen.push_back(p);
   p->chosen = true;
+  line_chosen[p->x]++;
+  line_chosen[n + p->y]++;
+
+  hash ^= zobrist[p - grid];
+  if (tt && (int)chosen.size() <= tt_depth) {
+    prefix.push_back(hash);
+  }
 }
 
 /**
- * Chooses a random point from the available set
+ * Queues a row (0..n-1) or column (n..2n-1) to be checked for forced moves
  */
-NTIAL_RAND::Point* NTIAL_RAND::choose_next() {
+inline void NTIAL_RAND::touch_line(int line) {
+  if (!queued[line]) {
+    queued[line] = true;
+    touched.push_back(line);
+  }
+}
+
+/**
+ * Queues every row and column to be checked for forced moves
+ */
+void NTIAL_RAND::touch_all_lines() {
+  for (int line = 0; line < 2*n; line++) {
+    touch_line(line);
+  }
+}
+
+/**
+ * Returns the first available point in a row (0..n-1) or column (n..2n-1)
+ */
+NTIAL_RAND::Point* NTIAL_RAND::first_available(int line) {
+  // Rows fix the x-coordinate and columns fix the y-coordinate
+  int x = (line < n) ? line : 0;
+  int y = (line < n) ? 0 : line - n;
+  int dx = (line < n) ? 0 : 1;
+  int dy = (line < n) ? 1 : 0;
+  Point *p;
+  for (int k = 0; k < n; k++, x += dx, y += dy) {
+    p = grid+IDX2(x,y,n);
+    if (p->available) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Applies forced choices in the rows and columns touched since the last call.
+ *   Returns false if some row or column can no longer hold two points.
+ */
+bool NTIAL_RAND::propagate_forced(bool symm) {
+  int line, quota;
+  bool consistent = true;
+
+  while (consistent && !touched.empty()) {
+    line = touched.back();
+    touched.pop_back();
+    queued[line] = false;
+
+    quota = 2 - line_chosen[line];
+    if (line_avail[line] < quota) {
+      // Dead end: this line can never be filled
+      consistent = false;
+    } else if (quota > 0 && line_avail[line] == quota) {
+      // Every remaining point of this line must be chosen. Choosing one
+      //   touches this line again, so the rest are picked up later.
+      Point *p = first_available(line);
+      if (symm) {
+        consistent = process_symm_point(p);
+      } else {
+        process_point(p);
+      }
+    }
+  }
+
+  // Drop whatever is left in the queue after a contradiction
+  while (!touched.empty()) {
+    queued[touched.back()] = false;
+    touched.pop_back();
+  }
+
+  return consistent;
+}
+
+/**
+ * Chooses a random point from the available set. symm indicates that the mirror image
+ *   of the point will be chosen with it.
+ */
+NTIAL_RAND::Point* NTIAL_RAND::choose_next(bool symm) {
   std::uniform_int_distribution<int> distribution(0, available.size() - 1);
-  int rand_idx = distribution(generator);
-  return available[rand_idx];
+  Point *p = available[distribution(generator)];
+
+  // While building a prefix, resample points that lead to known dead ends
+  if (tt && (int)chosen.size() < tt_depth) {
+    uint64_t key;
+    for (int attempt = 0; attempt < TT_RETRIES; attempt++) {
+      key = hash ^ zobrist[p - grid];
+      if (symm && p->x != p->y) {
+        key ^= zobrist[IDX2(p->y,p->x,n)];
+      }
+      if (!tt->is_dead(key)) {
+        break;
+      }
+      p = available[distribution(generator)];
+    }
+  }
+
+  return p;
+}
+
+/**
+ * Records the outcome of the current run for each of its prefixes
+ */
+void NTIAL_RAND::record_prefixes() {
+  if (tt) {
+    for (auto key : prefix) {
+      tt->record(key, chosen.size(), 2*n);
+    }
+  }
 }
 
 /**
@@ -240,32 +631,73 @@ void NTIAL_RAND::process_point(Point* p) {
   delete_point(p);
 }
 
+/**
+ * Chooses the point (x, y), and its mirror image if symm is set.
+ *   Returns false if the point is outside the grid or no longer available.
+ */
+bool NTIAL_RAND::add_point(int x, int y, bool symm) {
+  if (!in_grid(x, y) || !grid[IDX2(x,y,n)].available) {
+    return false;
+  }
+
+  bool added = true;
+  if (symm) {
+    added = process_symm_point(grid+IDX2(x,y,n));
+  } else {
+    process_point(grid+IDX2(x,y,n));
+  }
+  clear_unavailable();
+  return added;
+}
+
 /**
  * Attempts to find a maximal solution for the n*n No-Three-In-A-Line problem
+ *   Continues from the current state if points have already been chosen.
  *   Returns number of points chosen
  */
 int NTIAL_RAND::solve() {
-  // Pick a random point q
-  std::uniform_int_distribution<int> distribution(0, n-1);
-  int rand_i = distribution(generator);
-  int rand_j = distribution(generator);
-  Point *p = grid+IDX2(rand_i, rand_j, n);
+  Point *p;
 
-  /* std::cout << "Picked initial point: " << *p << std::endl; */
+  // Start from a random point unless continuing from a prefix
+  if (chosen.empty()) {
+    std::uniform_int_distribution<int> distribution(0, n-1);
+    int rand_i = distribution(generator);
+    int rand_j = distribution(generator);
+    p = grid+IDX2(rand_i, rand_j, n);
 
-  // Remove q and update state
-  choose_point(p);
-  delete_point(p);
+    /* std::cout << "Picked initial point: " << *p << std::endl; */
+
+    // Remove p and update state
+    choose_point(p);
+    delete_point(p);
+  }
+
+  if (propagate && !propagate_forced(false)) {
+    available.clear();
+  }
   clear_unavailable();
 
   // Iterate until all points are unavailable
+  interrupted = false;
   while (available.size() > 0) {
-    p = choose_next();
+    p = choose_next(false);
     /* std::cout << "\nIterating on point: " << *p << std::endl; */
     process_point(p);
+    if (propagate && !propagate_forced(false)) {
+      break;
+    }
+    if (stop_flag && stop_flag->load(std::memory_order_relaxed)) {
+      clear_unavailable();
+      interrupted = !available.empty();
+      break;
+    }
     clear_unavailable();
   }
 
+  // Runs cut short say nothing about their prefixes
+  if (!interrupted) {
+    record_prefixes();
+  }
   return chosen.size();
 }
 
@@ -276,51 +708,70 @@ NTIAL_RAND::Point* NTIAL_RAND::get_diag_symm(Point* p) {
   return grid + IDX2(p->y,p->x,n);
 }
 
+/**
+ * Chooses point p and its diagonally symmetric image. Does not modify available.
+ *   Returns false if the image is no longer available.
+ */
+bool NTIAL_RAND::process_symm_point(Point* p) {
+  process_point(p);
+
+  Point *q = get_diag_symm(p);
+  if (p == q) {
+    delete_line(q, 1, -1);
+  } else if (q->available) {
+    process_point(q);
+  } else {
+    return false;
+  }
+  return true;
+}
+
 /**
  * Attempts to find a maximal diagonally symmetric solution for the n*n No-Three-In-A-Line problem
+ *   Continues from the current state if points have already been chosen, which must then be symmetric.
  *   Returns number of points chosen
  */
 int NTIAL_RAND::solve_diag_symm() {
-  Point *p1, *p2;
-
-  // Pick a random point
-  std::uniform_int_distribution<int> distribution(0, n-1);
-  int rand_i = distribution(generator);
-  int rand_j = distribution(generator);
-  p1 = grid+IDX2(rand_i, rand_j, n);
+  Point *p1;
 
-  /* std::cout << "Picked initial point: " << *p << std::endl; */
+  // Start from a random point and its mirror image unless continuing from a prefix
+  if (chosen.empty()) {
+    std::uniform_int_distribution<int> distribution(0, n-1);
+    int rand_i = distribution(generator);
+    int rand_j = distribution(generator);
+    p1 = grid+IDX2(rand_i, rand_j, n);
 
-  // Remove first point
-  choose_point(p1);
-  delete_point(p1);
+    /* std::cout << "Picked initial point: " << *p1 << std::endl; */
 
-  // Remove mirror image
-  p2 = get_diag_symm(p1);
-  if (p1 == p2) {
-    delete_line(p2, 1, -1);
-  } else {
-    process_point(p2);
+    process_symm_point(p1);
   }
 
+  if (propagate && !propagate_forced(true)) {
+    available.clear();
+  }
   clear_unavailable();
 
   // Iterate until all points are unavailable
+  interrupted = false;
   while (available.size() > 0) {
-    // Choose new point
-    p1 = choose_next();
-    process_point(p1);
-
-    // Choose mirror image
-    p2 = get_diag_symm(p1);
-    if (p1 == p2) {
-      delete_line(p2, 1, -1);
-    } else {
-      process_point(p2);
-    }
+    // Choose new point and its mirror image
+    p1 = choose_next(true);
+    process_symm_point(p1);
 
+    if (propagate && !propagate_forced(true)) {
+      break;
+    }
+    if (stop_flag && stop_flag->load(std::memory_order_relaxed)) {
+      clear_unavailable();
+      interrupted = !available.empty();
+      break;
+    }
     clear_unavailable();
   }
 
+  // Runs cut short say nothing about their prefixes
+  if (!interrupted) {
+    record_prefixes();
+  }
   return chosen.size();
 }
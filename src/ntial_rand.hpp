@@ -4,8 +4,13 @@
 #include <vector>
 #include <list>
 #include <random>
+#include <string>
+#include <cstdint>
+#include <atomic>
+#include "ntial_tt.hpp"
 
-#define IDX2(i,j,i_stride) ((i)+(j*i_stride))
+#include "ntial_layout.hpp"
+#include "ntial_random.hpp"
 
 /**
  * An instance of the No-Three-In-A-Line problem
@@ -30,11 +35,37 @@ class NTIAL_RAND {
         int chosen;       // whether this point has been chosen
     };
 
+    /**
+     * A copy of the solver state between picks, which can be restored into any instance of the same size
+     */
+    class Snapshot {
+      public:
+        int n;                           // the size of the problem
+        std::vector<Point> grid;         // a copy of the GRID_CELLS(n) grid
+        std::vector<int> available;      // grid offsets of the available points
+        std::vector<int> chosen;         // grid offsets of the chosen points, in order
+        std::vector<int> line_avail;     // available points in each row and column
+        std::vector<int> line_chosen;    // chosen points in each row and column
+        uint64_t hash;                   // Zobrist hash of the chosen set
+        std::vector<uint64_t> prefix;    // hashes of the recorded prefix
+    };
+
     /**
      * Constructs an instance of the No-Three-In-A-Line problem
      */
     explicit NTIAL_RAND(int n);
 
+    /**
+     * Clones an instance of the No-Three-In-A-Line problem, including its random number generator.
+     *   Call seed() on the clone to make it diverge.
+     */
+    NTIAL_RAND(const NTIAL_RAND &other);
+
+    /**
+     * Copies the state of another instance, resizing this one if the sizes differ
+     */
+    NTIAL_RAND& operator=(const NTIAL_RAND &other);
+
     /**
      * Destroys an instance of the No-Three-In-A-Line problem
      */
@@ -55,28 +86,105 @@ class NTIAL_RAND {
      */
     void print_chosen();
 
+    /**
+     * Returns the number of points chosen
+     */
+    int get_chosen();
+
+    /**
+     * Returns the coordinates of the k-th chosen point
+     */
+    void get_point(int k, int &x, int &y);
+
     /**
      * FOR TESTING: retruns the internal grid
      */
     Point* get_grid();
     
     /**
-     * Resets an instantiated NTIAL_RAND problem.
+     * Resets an instantiated NTIAL_RAND problem. Returns to the warm start state if one is loaded.
      */
     void reset();
 
+    /**
+     * Loads a warm start configuration: a file of "x y" lines (blank lines and lines starting with
+     *   '#' are ignored). The points are applied to an empty grid, with their mirror images if symm
+     *   is set, and the resulting state is cached so that every reset() starts from it.
+     *   Returns false and leaves the problem cold if the file is unreadable or the points are invalid.
+     */
+    bool load_seed(const std::string &path, bool symm);
+
+    /**
+     * Drops the warm start configuration so that reset() returns to an empty grid
+     */
+    void clear_seed();
+
+    /**
+     * Reseeds the random number generator, keyed by (s, stream, call)
+     */
+    void seed(uint64_t s, uint64_t stream = 0, uint64_t call = 0);
+
+    /**
+     * Chooses the point (x, y), and its mirror image if symm is set.
+     *   Returns false if the point is outside the grid or no longer available.
+     */
+    bool add_point(int x, int y, bool symm);
+
+    /**
+     * Saves the current state. Must be called between picks.
+     */
+    void save(Snapshot &snapshot);
+
+    /**
+     * Restores a state saved from an instance of the same size.
+     *   Returns false, leaving the state unchanged, if the snapshot is of another size.
+     */
+    bool restore(const Snapshot &snapshot);
+
     /**
      * Attempts to find a maximal solution for the n*n No-Three-In-A-Line problem.
+     *   Continues from the current state if points have already been chosen.
      *   Returns number of points chosen
      */
     int solve();
 
     /**
      * Attempts to find a maximal diagonally symmetric solution for the n*n No-Three-In-A-Line problem
+     *   Continues from the current state if points have already been chosen, which must then be symmetric.
      *   Returns number of points chosen
      */
     int solve_diag_symm();
 
+    /**
+     * Enables or disables forced-move propagation. When enabled, the solvers target 2n points:
+     *   a row or column whose available points exactly fill its remaining quota forces those
+     *   choices, and the solve stops early once some row or column can no longer hold two points.
+     */
+    void set_propagation(bool enable);
+
+    /**
+     * Shares a transposition table of prefix outcomes with this solver. The first depth picks of
+     *   every run are recorded, and while building a prefix the solver resamples candidates whose
+     *   prefix is known to fail. Passing NULL detaches the table.
+     */
+    void set_transposition_table(NTIAL_TT* table, int depth);
+
+    /**
+     * Shares a flag that makes solves return early, before the solution is maximal, once it is set.
+     *   Passing NULL removes it.
+     */
+    void set_stop_flag(const std::atomic<bool>* flag);
+
+    /**
+     * Checks whether the stop flag cut the last solve short, leaving points available
+     */
+    bool was_interrupted();
+
+    /**
+     * Returns the Zobrist hash of the chosen set
+     */
+    uint64_t get_hash();
+
   private:
 
     /**
@@ -90,9 +198,15 @@ class NTIAL_RAND {
     inline void choose_point(Point * p);
 
     /**
-     * Chooses a random point from the available set
+     * Chooses a random point from the available set. symm indicates that the mirror image
+     *   of the point will be chosen with it.
      */
-    inline Point* choose_next();
+    inline Point* choose_next(bool symm);
+
+    /**
+     * Records the outcome of the current run for each of its prefixes
+     */
+    void record_prefixes();
 
     /**
      * Deletes points that became invalid after adding point p
@@ -119,6 +233,33 @@ class NTIAL_RAND {
      */
     inline void process_point(Point* p);
 
+    /**
+     * Chooses point p and its diagonally symmetric image. Does not modify available.
+     *   Returns false if the image is no longer available.
+     */
+    bool process_symm_point(Point* p);
+
+    /**
+     * Queues a row (0..n-1) or column (n..2n-1) to be checked for forced moves
+     */
+    inline void touch_line(int line);
+
+    /**
+     * Queues every row and column to be checked for forced moves
+     */
+    void touch_all_lines();
+
+    /**
+     * Returns the first available point in a row (0..n-1) or column (n..2n-1)
+     */
+    Point* first_available(int line);
+
+    /**
+     * Applies forced choices in the rows and columns touched since the last call.
+     *   Returns false if some row or column can no longer hold two points.
+     */
+    bool propagate_forced(bool symm);
+
     /**
      * Checks whether the point (x, y) is in the grid
      */
@@ -130,10 +271,28 @@ class NTIAL_RAND {
     inline Point* get_diag_symm(Point* p);
 
     int n;                                // The size of the No-Three-In-A-Line problem
-    Point* grid;                          // an n*n grid of Points
+    Point* grid;                          // an n*n grid of Points, laid out by IDX2
     std::vector<Point*> available;          // a list of the available points
     std::vector<Point*> chosen;           // a list of the chosen points
-    std::default_random_engine generator; // the random number generator
+    NTIAL_ENGINE generator;               // the random number generator
+
+    bool propagate;                       // whether forced moves are propagated after each pick
+    std::vector<int> line_avail;          // available points in each row (0..n-1) and column (n..2n-1)
+    std::vector<int> line_chosen;         // chosen points in each row and column
+    std::vector<int> touched;             // rows and columns to check for forced moves
+    std::vector<char> queued;             // whether each row and column is already in touched
+
+    std::vector<uint64_t> zobrist;        // a random key per point, identical for every instance of size n
+    uint64_t hash;                        // Zobrist hash of the chosen set
+    NTIAL_TT* tt;                         // shared table of prefix outcomes (may be NULL)
+    int tt_depth;                         // number of picks recorded in the table
+    std::vector<uint64_t> prefix;         // hashes of the chosen set after each of the first tt_depth picks
+
+    bool warm_start;                      // whether reset() restores warm
+    Snapshot warm;                        // the state after applying the warm start configuration
+
+    const std::atomic<bool>* stop_flag;   // when set, solves return early (may be NULL)
+    bool interrupted;                     // whether the stop flag cut the last solve short
 };
 
 #endif /* NTIAL_RAND_H */
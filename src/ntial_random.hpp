@@ -0,0 +1,81 @@
+#ifndef NTIAL_RANDOM_H
+#define NTIAL_RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * The random number generator of every solver: xoshiro256**, with 64-bit outputs and a
+ *   256-bit state, usable with the standard distributions.
+ *   seed() keys it by three words, chained through a bijective mix so that every state word,
+ *   and so the first output, depends on all of them, while distinct keys still give distinct
+ *   states. A campaign keys each run by (seed, stream, call), and no two runs replay the
+ *   same sequence.
+ */
+class NTIAL_ENGINE {
+
+  public:
+
+    typedef uint64_t result_type;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * Constructs a generator keyed by (key, stream, call)
+     */
+    explicit NTIAL_ENGINE(uint64_t key = 0, uint64_t stream = 0, uint64_t call = 0) {
+      seed(key, stream, call);
+    }
+
+    /**
+     * Keys the generator by (key, stream, call)
+     */
+    void seed(uint64_t key, uint64_t stream = 0, uint64_t call = 0) {
+      // Each word mixes the previous one into its input, so state[1], which the first
+      //   output reads, depends on all three words, and (state[0], state[2], state[1])
+      //   still determines (key, stream, call)
+      state[0] = mix(key);
+      state[2] = mix(stream + state[0]);
+      state[1] = mix(call + state[2]);
+      state[3] = mix(state[1]) ^ 0x6A09E667F3BCC909ull;   // nonzero when state[1] is 0
+    }
+
+    /**
+     * Returns the next 64 random bits
+     */
+    result_type operator()() {
+      uint64_t result = rotl(state[1] * 5, 7) * 9;
+      uint64_t t = state[1] << 17;
+      state[2] ^= state[0];
+      state[3] ^= state[1];
+      state[1] ^= state[2];
+      state[0] ^= state[3];
+      state[2] ^= t;
+      state[3] = rotl(state[3], 45);
+      return result;
+    }
+
+  private:
+
+    /**
+     * Mixes the bits of x (splitmix64), a bijection on 64-bit words
+     */
+    static uint64_t mix(uint64_t x) {
+      x += 0x9E3779B97F4A7C15ull;
+      x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+      x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+      return x ^ (x >> 31);
+    }
+
+    /**
+     * Rotates x left by k bits
+     */
+    static uint64_t rotl(uint64_t x, int k) {
+      return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t state[4];    // the generator state
+};
+
+#endif /* NTIAL_RANDOM_H */
@@ -0,0 +1,320 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include "ntial_symm.hpp"
+
+using std::vector;
+using std::string;
+
+// Offset of (x, y), x <= y, in the row-by-row upper triangle of an n*n grid
+#define TRI_IDX(x,y,n) ((x)*(n) - ((x)*((x)-1))/2 + ((y)-(x)))
+
+/****************************
+ * Point member definitions *
+ ****************************/
+/**
+ * Prints a point to the output stream
+ */
+std::ostream& operator<<(std::ostream &output, const NTIAL_SYMM::Point &p) {
+  output << "( x: " << p.x << ", y: " << p.y << ", a?: " << p.available << ", c?: " << p.chosen << " )";
+  return output;
+}
+
+
+/***************************
+ * NTIAL_SYMM member definitions *
+ ****************************/
+/**
+ * Constructs an instance of the No-Three-In-A-Line problem
+ */
+NTIAL_SYMM::NTIAL_SYMM(int N) {
+  n = N;
+  stop_flag = NULL;
+  interrupted = false;
+
+  // Allocate memory
+  grid = (Point*)malloc(n*(n+1)/2*sizeof(Point));
+
+  // Initialize data
+  init_data();
+
+  // obtain a seed from the system clock
+  uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+  generator.seed(seed);
+}
+
+/**
+ * Destroys an instance of the No-Three-In-A-Line problem
+ */
+NTIAL_SYMM::~NTIAL_SYMM() {
+  free(grid);
+}
+
+/**
+ * Initializes data structures. Assumes chosen is empty.
+ */
+void NTIAL_SYMM::init_data() {
+  // Fill data structures with points
+  Point *p = grid;
+  for (int i = 0; i < n; i++) {
+    for (int j = i; j < n; j++, p++) {
+      p->x = i;
+      p->y = j;
+      p->available = true;
+      p->chosen = false;
+    }
+  }
+
+  // Fill available array
+  for (p = grid; p < grid + n*(n+1)/2; p++) {
+    available.push_back(p);
+  }
+
+  num_chosen = 0;
+}
+
+/**
+ * Resets an instantiated NTIAL_SYMM problem.
+ */
+void NTIAL_SYMM::reset() {
+  // Clear data structures vector
+  chosen.clear();
+  available.clear();
+
+  // Reinitialize data
+  init_data();
+}
+
+/**
+ * Reseeds the random number generator, keyed by (s, stream, call)
+ */
+void NTIAL_SYMM::seed(uint64_t s, uint64_t stream, uint64_t call) {
+  generator.seed(s, stream, call);
+}
+
+/**
+ * Shares a flag that makes solves return early once it is set.
+ */
+void NTIAL_SYMM::set_stop_flag(const std::atomic<bool>* flag) {
+  stop_flag = flag;
+}
+
+/**
+ * Checks whether the stop flag cut the last solve short, leaving points available
+ */
+bool NTIAL_SYMM::was_interrupted() {
+  return interrupted;
+}
+
+/**
+ * Prints current state of the full grid to stdout. '*' indicates chosen points.
+ */
+void NTIAL_SYMM::print_grid() {
+  string border (n+2, '-');
+
+  // Print top border
+  std::cout << border << std::endl;
+
+  for (int i = 0; i < n; i++) {
+    // Print next row
+    std::cout << '|';
+    for (int j = 0; j < n; j++) {
+      if (cell(i,j)->chosen) {
+        std::cout << '*';
+      } else {
+        std::cout << ' ';
+      }
+    }
+    std::cout << '|' << std::endl;
+  }
+
+  // Print bottom border
+  std::cout << border << std::endl;
+}
+
+/**
+ * Prints current list of available points in the upper triangle.
+ */
+void NTIAL_SYMM::print_available() {
+  for (auto p : available) {
+    std::cout << *p << std::endl;
+  }
+}
+
+/**
+ * Prints current list of chosen points in the upper triangle.
+ */
+void NTIAL_SYMM::print_chosen() {
+  for (auto p : chosen) {
+    std::cout << *p << std::endl;
+  }
+}
+
+/**
+ * Returns the number of points chosen in the full grid
+ */
+int NTIAL_SYMM::get_chosen() {
+  return num_chosen;
+}
+
+/**
+ * Returns the coordinates of the k-th chosen point of the full grid.
+ */
+void NTIAL_SYMM::get_point(int k, int &x, int &y) {
+  for (auto p : chosen) {
+    if (k == 0) {
+      x = p->x;
+      y = p->y;
+      return;
+    }
+    if (p->x != p->y) {
+      if (k == 1) {
+        x = p->y;
+        y = p->x;
+        return;
+      }
+      k--;
+    }
+    k--;
+  }
+}
+
+/**
+ * Returns the stored point for (x, y) or its mirror image
+ */
+inline NTIAL_SYMM::Point* NTIAL_SYMM::cell(int x, int y) {
+  return (x <= y) ? grid+TRI_IDX(x,y,n) : grid+TRI_IDX(y,x,n);
+}
+
+/**
+ * Checks whether the point (x, y) is in the grid
+ */
+inline bool NTIAL_SYMM::in_grid(int x, int y) {
+  return (0 <= x) && (x < n) && (0 <= y) && (y < n);
+}
+
+/**
+ * Deletes the point p and its mirror image
+ */
+inline void NTIAL_SYMM::delete_point(Point * p) {
+  p->available = false;
+}
+
+/**
+ * Chooses the point p and its mirror image
+ */
+inline void NTIAL_SYMM::choose_point(Point * p) {
+  chosen.push_back(p);
+  p->chosen = true;
+  num_chosen += (p->x == p->y) ? 1 : 2;
+}
+
+/**
+ * Chooses a random point from the available set, with the probability it would have in the full grid
+ */
+NTIAL_SYMM::Point* NTIAL_SYMM::choose_next() {
+  std::uniform_int_distribution<int> distribution(0, available.size() - 1);
+  Point *p = available[distribution(generator)];
+
+  // Off-diagonal points stand for two points of the full grid, so diagonal
+  //   points are kept with probability 1/2
+  while (p->x == p->y && (generator() & 1)) {
+    p = available[distribution(generator)];
+  }
+  return p;
+}
+
+/**
+ * Deletes points along the full-grid line through (x, y) with given slope
+ */
+void NTIAL_SYMM::delete_line(int x0, int y0, int rise, int run) {
+  int x, y;
+  x = x0 + run;
+  y = y0 + rise;
+  while (in_grid(x, y)) {
+    delete_point(cell(x,y));
+    x += run;
+    y += rise;
+  }
+  x = x0 - run;
+  y = y0 - rise;
+  while (in_grid(x, y)) {
+    delete_point(cell(x,y));
+    x -= run;
+    y -= rise;
+  }
+}
+
+/**
+ * Deletes points that became invalid after adding point p and its mirror image
+ */
+void NTIAL_SYMM::delete_invalid_points(Point * p) {
+  // Deletions around the mirror image of p are the mirror images of deletions
+  //   around p, and cell() folds both halves together, so only lines through p
+  //   are walked: one to each chosen point and one to its mirror image.
+  int rise, run, gcd;
+  for (auto q : chosen) {
+    run  = p->x - q->x;
+    rise = p->y - q->y;
+    gcd = std::__gcd(run, rise);
+    delete_line(p->x, p->y, rise/gcd, run/gcd);
+
+    if (q->x != q->y) {
+      run  = p->x - q->y;
+      rise = p->y - q->x;
+      gcd = std::__gcd(run, rise);
+      delete_line(p->x, p->y, rise/gcd, run/gcd);
+    }
+  }
+
+  // The line through p and its mirror image (or, for a diagonal p, the line
+  //   through p and any mirrored pair) is perpendicular to the diagonal
+  delete_line(p->x, p->y, 1, -1);
+}
+
+/**
+ * Removes invalid entries from the available list
+ */
+void NTIAL_SYMM::clear_unavailable() {
+  size_t cur = 0;
+  size_t end = available.size();
+
+  // Items to the left of cur are available
+  while (cur < end) {
+    if (available[cur]->available) {
+      cur++;
+    } else {
+      // Move cur to end for deletion
+      available[cur] = available[--end];
+    }
+  }
+
+  available.resize(cur);
+}
+
+/**
+ * Chooses point p and updates state. Does not modify available.
+ */
+void NTIAL_SYMM::process_point(Point* p) {
+  delete_invalid_points(p);
+  choose_point(p);
+  delete_point(p);
+}
+
+/**
+ * Attempts to find a maximal diagonally symmetric solution for the n*n No-Three-In-A-Line problem
+ *   Returns number of points chosen in the full grid
+ */
+int NTIAL_SYMM::solve() {
+  // Iterate until all points are unavailable
+  while (available.size() > 0 && !(stop_flag && stop_flag->load(std::memory_order_relaxed))) {
+    process_point(choose_next());
+    clear_unavailable();
+  }
+
+  interrupted = available.size() > 0;
+  return num_chosen;
+}
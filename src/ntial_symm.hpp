@@ -0,0 +1,158 @@
+#ifndef NTIAL_SYMM_H
+#define NTIAL_SYMM_H
+
+#include <vector>
+#include <random>
+#include <atomic>
+#include "ntial_random.hpp"
+
+/**
+ * An instance of the diagonally symmetric No-Three-In-A-Line problem. Only the upper triangle
+ *   (x <= y) of the n*n grid is stored; choosing a point implicitly chooses its mirror image.
+ */
+class NTIAL_SYMM {
+
+  public:
+
+    /**
+     * A point in the upper triangle of the n*n grid of the NTIAL_SYMM problem
+     */
+    class Point {
+      public:
+        /**
+         * Prints a point to the output stream
+         */
+        friend std::ostream& operator<<(std::ostream &output, const Point &p);
+
+        int x;            // x-coordinate (x <= y)
+        int y;            // y-coordinate
+        int available;    // whether this point (and its mirror image) is available
+        int chosen;       // whether this point (and its mirror image) has been chosen
+    };
+
+    /**
+     * Constructs an instance of the No-Three-In-A-Line problem
+     */
+    explicit NTIAL_SYMM(int n);
+
+    /**
+     * Destroys an instance of the No-Three-In-A-Line problem
+     */
+    ~NTIAL_SYMM();
+
+    /**
+     * Prints current state of the full grid to stdout. '*' indicates chosen points.
+     */
+    void print_grid();
+
+    /**
+     * Prints current list of available points in the upper triangle.
+     */
+    void print_available();
+
+    /**
+     * Prints current list of chosen points in the upper triangle.
+     */
+    void print_chosen();
+
+    /**
+     * Returns the number of points chosen in the full grid
+     */
+    int get_chosen();
+
+    /**
+     * Returns the coordinates of the k-th chosen point of the full grid. Each off-diagonal
+     *   point of the triangle is followed by its mirror image.
+     */
+    void get_point(int k, int &x, int &y);
+
+    /**
+     * Resets an instantiated NTIAL_SYMM problem.
+     */
+    void reset();
+
+    /**
+     * Reseeds the random number generator, keyed by (s, stream, call)
+     */
+    void seed(uint64_t s, uint64_t stream = 0, uint64_t call = 0);
+
+    /**
+     * Shares a flag that makes solves return early, before the solution is maximal, once it is set.
+     *   Passing NULL removes it.
+     */
+    void set_stop_flag(const std::atomic<bool>* flag);
+
+    /**
+     * Checks whether the stop flag cut the last solve short, leaving points available
+     */
+    bool was_interrupted();
+
+    /**
+     * Attempts to find a maximal diagonally symmetric solution for the n*n No-Three-In-A-Line problem
+     *   Returns number of points chosen in the full grid
+     */
+    int solve();
+
+  private:
+
+    /**
+     * Initializes data structures. Assumes chosen is empty.
+     */
+    void init_data();
+
+    /**
+     * Returns the stored point for (x, y) or its mirror image
+     */
+    inline Point* cell(int x, int y);
+
+    /**
+     * Chooses the point p and its mirror image
+     */
+    inline void choose_point(Point * p);
+
+    /**
+     * Chooses a random point from the available set, with the probability it would have in the full grid
+     */
+    inline Point* choose_next();
+
+    /**
+     * Deletes points that became invalid after adding point p and its mirror image
+     */
+    void delete_invalid_points(Point * p);
+
+    /**
+     * Deletes the point p and its mirror image
+     */
+    inline void delete_point(Point * p);
+
+    /**
+     * Deletes points along the full-grid line through (x, y) with given slope
+     */
+    inline void delete_line(int x, int y, int rise, int run);
+
+    /**
+     * Removes invalid entries from the available list
+     */
+    void clear_unavailable();
+
+    /**
+     * Chooses point p and updates state. Does not modify available.
+     */
+    inline void process_point(Point* p);
+
+    /**
+     * Checks whether the point (x, y) is in the grid
+     */
+    inline bool in_grid(int x, int y);
+
+    int n;                                // The size of the No-Three-In-A-Line problem
+    Point* grid;                          // the n*(n+1)/2 points of the upper triangle, row by row
+    std::vector<Point*> available;        // a list of the available points
+    std::vector<Point*> chosen;           // a list of the chosen points
+    int num_chosen;                       // number of points chosen in the full grid
+    NTIAL_ENGINE generator;               // the random number generator
+    const std::atomic<bool>* stop_flag;   // when set, solves return early (may be NULL)
+    bool interrupted;                     // whether the stop flag cut the last solve short
+};
+
+#endif /* NTIAL_SYMM_H */
@@ -0,0 +1,101 @@
+#include <atomic>
+#include <cstdint>
+#include "ntial_tt.hpp"
+
+// Layout of a data word: visits in the low 32 bits, then hits and best size in 16 bits each
+#define TT_VISITS(d) ((d) & 0xFFFFFFFFull)
+#define TT_HITS(d)   (((d) >> 32) & 0xFFFFull)
+#define TT_BEST(d)   ((d) >> 48)
+#define TT_PACK(visits, hits, best) ((uint64_t)(visits) | ((uint64_t)(hits) << 32) | ((uint64_t)(best) << 48))
+
+// Hits a prefix would have had at the table's overall hit rate before its lack of hits counts.
+//   An average prefix goes without a hit that long with probability about 1/e, but pruning it
+//   costs little, and 2 or 3 found fewer 2n solutions per run at n = 7 and 8.
+#define TT_DEAD_HITS 1
+
+/**
+ * Constructs a table with 2^log2_entries slots.
+ */
+NTIAL_TT::NTIAL_TT(int log2_entries, int min_visits) {
+  this->min_visits = min_visits;
+  mask = (1ull << log2_entries) - 1;
+  table = new Entry[mask + 1];
+  clear();
+}
+
+/**
+ * Destroys the table
+ */
+NTIAL_TT::~NTIAL_TT() {
+  delete[] table;
+}
+
+/**
+ * Empties every slot
+ */
+void NTIAL_TT::clear() {
+  for (uint64_t i = 0; i <= mask; i++) {
+    table[i].data.store(0, std::memory_order_relaxed);
+    table[i].check.store(0, std::memory_order_relaxed);
+  }
+  total_visits.store(0, std::memory_order_relaxed);
+  total_hits.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Records that a run through the prefix with the given key ended with result points
+ */
+void NTIAL_TT::record(uint64_t key, int result, int target) {
+  Entry &e = table[key & mask];
+  uint64_t data  = e.data.load(std::memory_order_relaxed);
+  uint64_t check = e.check.load(std::memory_order_relaxed);
+
+  uint64_t visits = 0, hits = 0, best = 0;
+  if ((check ^ data) == key) {
+    visits = TT_VISITS(data);
+    hits   = TT_HITS(data);
+    best   = TT_BEST(data);
+  }
+  // Otherwise the slot is empty, torn or owned by another prefix: replace it
+
+  if (visits < 0xFFFFFFFFull) visits++;
+  if (result >= target && hits < 0xFFFFull) hits++;
+  total_visits.fetch_add(1, std::memory_order_relaxed);
+  if (result >= target) total_hits.fetch_add(1, std::memory_order_relaxed);
+  if ((uint64_t)result > best) best = result;
+
+  data = TT_PACK(visits, hits, best);
+  e.data.store(data, std::memory_order_relaxed);
+  e.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+/**
+ * Looks up the prefix with the given key. Returns false if it is not in the table.
+ */
+bool NTIAL_TT::lookup(uint64_t key, int &visits, int &hits, int &best) const {
+  const Entry &e = table[key & mask];
+  uint64_t data  = e.data.load(std::memory_order_relaxed);
+  uint64_t check = e.check.load(std::memory_order_relaxed);
+
+  if ((check ^ data) != key || data == 0) {
+    return false;
+  }
+  visits = TT_VISITS(data);
+  hits   = TT_HITS(data);
+  best   = TT_BEST(data);
+  return true;
+}
+
+/**
+ * Checks whether the prefix with the given key is known to fail: it has no hits after
+ *   enough visits to expect TT_DEAD_HITS of them at the table's overall hit rate
+ */
+bool NTIAL_TT::is_dead(uint64_t key) const {
+  int visits, hits, best;
+  if (!lookup(key, visits, hits, best) || hits != 0 || visits < min_visits) {
+    return false;
+  }
+  uint64_t all_visits = total_visits.load(std::memory_order_relaxed);
+  uint64_t all_hits   = total_hits.load(std::memory_order_relaxed);
+  return all_hits > 0 && (uint64_t)visits * all_hits >= TT_DEAD_HITS * all_visits;
+}
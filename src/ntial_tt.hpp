@@ -0,0 +1,68 @@
+#ifndef NTIAL_TT_H
+#define NTIAL_TT_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A bounded, lossy transposition table of prefix outcomes, shared between solver threads.
+ *   Keys are Zobrist hashes of chosen sets. Entries are written without locks; a torn
+ *   write fails the key check on the next read and is treated as an empty slot.
+ */
+class NTIAL_TT {
+
+  public:
+
+    /**
+     * Constructs a table with 2^log2_entries slots. A prefix is reported dead once it has
+     *   been visited at least min_visits times without reaching the target, and so often that
+     *   the table's overall hit rate would have given it TT_DEAD_HITS hits. This pays where the
+     *   target is common: symmetric, propagated runs at depth 4 found 2.6x (n = 7), 1.8x (n = 8)
+     *   and 1.15x (n = 9) more 2n solutions per run. From n = 10, where about 0.1% of runs reach
+     *   2n, few prefixes are visited that often and the table only costs time.
+     */
+    NTIAL_TT(int log2_entries, int min_visits);
+
+    /**
+     * Destroys the table
+     */
+    ~NTIAL_TT();
+
+    /**
+     * Empties every slot
+     */
+    void clear();
+
+    /**
+     * Records that a run through the prefix with the given key ended with result points
+     */
+    void record(uint64_t key, int result, int target);
+
+    /**
+     * Looks up the prefix with the given key. Returns false if it is not in the table.
+     */
+    bool lookup(uint64_t key, int &visits, int &hits, int &best) const;
+
+    /**
+     * Checks whether the prefix with the given key is known to fail
+     */
+    bool is_dead(uint64_t key) const;
+
+  private:
+
+    /**
+     * A slot of the table. check holds key ^ data so that torn writes are detected.
+     */
+    struct Entry {
+      std::atomic<uint64_t> check;
+      std::atomic<uint64_t> data;
+    };
+
+    Entry* table;                       // the slots of the table
+    uint64_t mask;                      // number of slots minus one
+    int min_visits;                     // visits without a hit before a prefix is considered dead
+    std::atomic<uint64_t> total_visits; // records over every prefix
+    std::atomic<uint64_t> total_hits;   // records that reached the target
+};
+
+#endif /* NTIAL_TT_H */
@@ -0,0 +1,165 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "ntial_validate.hpp"
+
+using std::vector;
+using std::string;
+
+/**
+ * Formats the point (x, y)
+ */
+static string point(int x, int y) {
+  return "(" + std::to_string(x) + ", " + std::to_string(y) + ")";
+}
+
+/**
+ * Returns the greatest common divisor of a and b
+ */
+static int gcd(int a, int b) {
+  while (b != 0) {
+    int r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+
+/***************************
+ * NTIAL_VALIDATE member definitions *
+ ****************************/
+/**
+ * Constructs a validator for solutions on an n*n grid
+ */
+NTIAL_VALIDATE::NTIAL_VALIDATE(int n) : n(n), width(2*n - 1), stamp(0) {
+  // Map every direction (dx, dy), dy >= 0, to its reduced form
+  reduced.assign(n * width, 0);
+  for (int dy = 0; dy < n; dy++) {
+    for (int dx = -(n-1); dx <= n-1; dx++) {
+      int g = std::max(gcd(std::abs(dx), dy), 1);
+      reduced[dy*width + dx + n-1] = (dy/g)*width + dx/g + n-1;
+    }
+  }
+  seen.assign(n * width, 0);
+  partner.assign(n * width, 0);
+}
+
+/**
+ * Returns the index of the reduced direction from (x1, y1) to (x2, y2)
+ */
+int NTIAL_VALIDATE::direction(int x1, int y1, int x2, int y2) {
+  int dx = x2 - x1;
+  int dy = y2 - y1;
+
+  // Opposite directions are the same line
+  if (dy < 0 || (dy == 0 && dx < 0)) {
+    dx = -dx;
+    dy = -dy;
+  }
+  return reduced[dy*width + dx + n-1];
+}
+
+/**
+ * Checks that the points (xs[k], ys[k]) lie on the grid, are distinct and that no three
+ *   of them are in a line. O(k^2) for k points.
+ */
+bool NTIAL_VALIDATE::no_three_in_line(const vector<int> &xs, const vector<int> &ys) {
+  size_t k = xs.size();
+  if (ys.size() != k) {
+    error = "the point lists have different lengths";
+    return false;
+  }
+
+  covered.assign(n*n, 0);
+  for (size_t i = 0; i < k; i++) {
+    if (xs[i] < 0 || xs[i] >= n || ys[i] < 0 || ys[i] >= n) {
+      error = point(xs[i], ys[i]) + " is outside the grid";
+      return false;
+    }
+    if (covered[xs[i]*n + ys[i]]++) {
+      error = point(xs[i], ys[i]) + " is chosen twice";
+      return false;
+    }
+  }
+
+  // A third point in a line with points i and j < l is seen twice in the same direction from i
+  for (size_t i = 0; i < k; i++) {
+    if (++stamp == 0) {
+      std::fill(seen.begin(), seen.end(), 0);
+      stamp = 1;
+    }
+    for (size_t l = i + 1; l < k; l++) {
+      int d = direction(xs[i], ys[i], xs[l], ys[l]);
+      if (seen[d] == stamp) {
+        int j = partner[d];
+        error = point(xs[i], ys[i]) + ", " + point(xs[j], ys[j]) + " and " + point(xs[l], ys[l]) + " are in a line";
+        return false;
+      }
+      seen[d] = stamp;
+      partner[d] = l;
+    }
+  }
+
+  error.clear();
+  return true;
+}
+
+/**
+ * Checks that no grid point can be added to the points without making three in a line.
+ *   The points must pass no_three_in_line(). O(k^2 n) for k points.
+ */
+bool NTIAL_VALIDATE::is_maximal(const vector<int> &xs, const vector<int> &ys) {
+  size_t k = xs.size();
+
+  covered.assign(n*n, 0);
+  for (size_t i = 0; i < k; i++) {
+    covered[xs[i]*n + ys[i]] = 1;
+  }
+
+  // Cover the line through every pair; no two pairs share a line
+  for (size_t i = 0; i < k; i++) {
+    for (size_t j = i + 1; j < k; j++) {
+      int d = direction(xs[i], ys[i], xs[j], ys[j]);
+      int dx = d % width - (n-1);
+      int dy = d / width;
+
+      int x = xs[i];
+      int y = ys[i];
+      while (x - dx >= 0 && x - dx < n && y - dy >= 0) {
+        x -= dx;
+        y -= dy;
+      }
+      for (; x >= 0 && x < n && y < n; x += dx, y += dy) {
+        covered[x*n + y] = 1;
+      }
+    }
+  }
+
+  for (int x = 0; x < n; x++) {
+    for (int y = 0; y < n; y++) {
+      if (!covered[x*n + y]) {
+        error = point(x, y) + " can still be added";
+        return false;
+      }
+    }
+  }
+
+  error.clear();
+  return true;
+}
+
+/**
+ * Runs no_three_in_line() and, if maximal is set, is_maximal()
+ */
+bool NTIAL_VALIDATE::validate(const vector<int> &xs, const vector<int> &ys, bool maximal) {
+  return no_three_in_line(xs, ys) && (!maximal || is_maximal(xs, ys));
+}
+
+/**
+ * Describes why the last check failed
+ */
+const string& NTIAL_VALIDATE::get_error() {
+  return error;
+}
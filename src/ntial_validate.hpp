@@ -0,0 +1,62 @@
+#ifndef NTIAL_VALIDATE_H
+#define NTIAL_VALIDATE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Checks solutions independently of the solvers that produced them.
+ *   Collinearity is tested by slope hashing: for each point, the reduced directions to the
+ *   other points index a stamp table, so a repeated direction (a third point on a line) is
+ *   found in O(k^2) for k points. A validator keeps its tables between calls, so it can
+ *   audit every solution of a campaign inline.
+ */
+class NTIAL_VALIDATE {
+
+  public:
+
+    /**
+     * Constructs a validator for solutions on an n*n grid
+     */
+    explicit NTIAL_VALIDATE(int n);
+
+    /**
+     * Checks that the points (xs[k], ys[k]) lie on the grid, are distinct and that no three
+     *   of them are in a line. O(k^2) for k points.
+     */
+    bool no_three_in_line(const std::vector<int> &xs, const std::vector<int> &ys);
+
+    /**
+     * Checks that no grid point can be added to the points without making three in a line.
+     *   The points must pass no_three_in_line(). O(k^2 n) for k points.
+     */
+    bool is_maximal(const std::vector<int> &xs, const std::vector<int> &ys);
+
+    /**
+     * Runs no_three_in_line() and, if maximal is set, is_maximal()
+     */
+    bool validate(const std::vector<int> &xs, const std::vector<int> &ys, bool maximal);
+
+    /**
+     * Describes why the last check failed
+     */
+    const std::string& get_error();
+
+  private:
+
+    /**
+     * Returns the index of the reduced direction from (x1, y1) to (x2, y2)
+     */
+    int direction(int x1, int y1, int x2, int y2);
+
+    int n;                      // size of the grid
+    int width;                  // number of dx values, 2n - 1
+    std::vector<int> reduced;   // reduced direction index of every raw (dx, dy), dy >= 0
+    std::vector<unsigned> seen; // stamp of the point that last saw each direction
+    std::vector<int> partner;   // the point seen in each direction
+    unsigned stamp;             // current stamp
+    std::vector<char> covered;  // grid cells on a line through two points
+    std::string error;          // reason of the last failure
+};
+
+#endif /* NTIAL_VALIDATE_H */
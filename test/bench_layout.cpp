@@ -0,0 +1,36 @@
+#include <iostream>
+#include <chrono>
+#include "../src/ntial_rand.hpp"
+
+int main () {
+    int n;
+    std::cout << "n: ";
+    std::cin >> n;
+
+    int runs;
+    std::cout << "runs: ";
+    std::cin >> runs;
+
+#if defined(NTIAL_LAYOUT_TILED)
+    const char *layout = "tiled";
+#elif defined(NTIAL_LAYOUT_MORTON)
+    const char *layout = "morton";
+#else
+    const char *layout = "flat";
+#endif
+
+    // Single-threaded so that runs are comparable between layouts
+    NTIAL_RAND prob (n);
+    long total = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+      prob.reset();
+      total += prob.solve();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\nlayout: " << layout << ", cells: " << GRID_CELLS(n)
+              << ", mean chosen: " << (double)total / runs
+              << ", seconds per run: " << elapsed.count() / runs << std::endl;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 /* #include "../src/ntial_dr.hpp" */
 #include "../src/ntial_rand.hpp"
+#include "../src/ntial_batch.hpp"
 
 int main () {
     int n;
@@ -13,6 +14,23 @@ int main () {
     
     bool solved = false;
     
+    // Small grids run BATCH_LANES trials at a time
+    if (n <= BATCH_MAX_N) {
+      int batches = (runs + BATCH_LANES - 1) / BATCH_LANES;
+
+      #pragma omp parallel for
+      for (int i = 0; i < batches; i++) {
+        NTIAL_BATCH batch (n);
+        batch.solve();
+
+        #pragma omp critical
+        for (int lane = 0; lane < batch.lanes() && i*batch.lanes() + lane < runs; lane++) {
+          batch.print_grid(lane);
+        }
+      }
+      return 0;
+    }
+
     #pragma omp parallel for private(solved)
     for (int i = 0; i < runs; i++) {
       // NTIAL_DR prob (n);
@@ -1,17 +1,32 @@
 #include <iostream>
+#include <chrono>
+#include <omp.h>
 /* #include "../src/ntial_dr.hpp" */
 #include "../src/ntial_rand.hpp"
 
-int main () {
+int main (int argc, char *argv[]) {
     int n;
     std::cout << "n: ";
     std::cin >> n;
     
-    #pragma omp parallel shared(n)
+    // An optional warm start file is applied once and shared by every thread
+    NTIAL_RAND base (n);
+    base.set_propagation(true);
+    if (argc > 1 && !base.load_seed(argv[1], true)) {
+        return 1;
+    }
+
+    // Prefix outcomes are shared between threads
+    NTIAL_TT tt (20, 8);
+
+    #pragma omp parallel shared(n, tt, base)
     {
         int chosen;
         // NTIAL_DR prob (n);
-        NTIAL_RAND prob (n);
+        NTIAL_RAND prob (base);
+        prob.seed(std::chrono::system_clock::now().time_since_epoch().count() + omp_get_thread_num());
+        prob.set_propagation(true);
+        prob.set_transposition_table(&tt, 4);
     
         bool solved = false;
     
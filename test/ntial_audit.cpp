@@ -0,0 +1,155 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <getopt.h>
+#include "../src/ntial_campaign.hpp"
+#include "../src/ntial_validate.hpp"
+
+/**
+ * Prints the usage message
+ */
+static void usage(const char *name) {
+    std::cerr << "usage: " << name << " [options] FILE...\n"
+              << "  Checks every solution in the binary results files written by ntial_driver --results,\n"
+              << "  or, with --n, in point lists of \"x y\" lines (lines starting with # are ignored).\n"
+              << "  -n, --n N                the files are point lists for an N*N grid\n"
+              << "  -y, --symm               the point lists are symmetric or propagated solutions; skip\n"
+              << "                           the maximality check of those with fewer than 2n points.\n"
+              << "                           Results files record this in their campaign settings.\n";
+}
+
+/**
+ * Reads a point list. Returns false if it cannot be read.
+ */
+static bool read_points(const char *path, std::vector<int> &xs, std::vector<int> &ys) {
+    std::ifstream in (path);
+    if (!in) {
+        std::cerr << path << ": cannot open point list" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        // Only blank lines and comments are skipped; any other line must be exactly two integers
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+        std::istringstream fields (line);
+        int x, y;
+        if (!(fields >> x >> y) || !(fields >> std::ws).eof()) {
+            std::cerr << path << ":" << line_no << ": expected \"x y\"" << std::endl;
+            return false;
+        }
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+    return true;
+}
+
+/**
+ * Returns the value of key in a campaign signature of "key value" pairs, or "" if it is absent
+ */
+static std::string setting(const std::string &signature, const std::string &key) {
+    std::istringstream fields (signature);
+    std::string name, value;
+    while (fields >> name >> value) {
+        if (name == key) {
+            return value;
+        }
+    }
+    return "";
+}
+
+/**
+ * Checks one solution, printing the reason if it is invalid
+ */
+static bool check(const std::string &where, NTIAL_VALIDATE &validator, const std::vector<int> &xs,
+                  const std::vector<int> &ys, bool maximal) {
+    if (validator.validate(xs, ys, maximal)) {
+        return true;
+    }
+    std::cout << where << ": " << validator.get_error() << std::endl;
+    return false;
+}
+
+int main (int argc, char *argv[]) {
+    int n = 0;
+    bool symm = false;
+
+    static struct option long_options[] = {
+        {"n",    required_argument, 0, 'n'},
+        {"symm", no_argument,       0, 'y'},
+        {"help", no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "n:yh", long_options, NULL)) != -1) {
+        switch (c) {
+            case 'n': n = atoi(optarg); break;
+            case 'y': symm = true; break;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 1;
+        }
+    }
+    if (optind == argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    long checked = 0, invalid = 0;
+    for (int i = optind; i < argc; i++) {
+        if (n > 0) {
+            std::vector<int> xs, ys;
+            if (!read_points(argv[i], xs, ys)) {
+                return 1;
+            }
+            NTIAL_VALIDATE validator (n);
+            checked++;
+            invalid += !check(argv[i], validator, xs, ys, !symm || (int)xs.size() == 2*n);
+            continue;
+        }
+
+        NTIAL_CAMPAIGN::Options tag;
+        std::string signature;
+        std::vector<NTIAL_CAMPAIGN::Result> results;
+        if (!NTIAL_CAMPAIGN::load_results(argv[i], tag, signature, results)) {
+            return 1;
+        }
+
+        // Symmetric runs are maximal only among symmetric sets, and propagated runs stop
+        //   early once they cannot reach 2n; only their 2n solutions are checked for maximality
+        bool maximal = (setting(signature, "symm") == "0" && setting(signature, "propagate") == "0");
+
+        for (auto &result : results) {
+            NTIAL_VALIDATE validator (result.n);
+            std::string where = std::string(argv[i]) + ": n = " + std::to_string(result.n);
+
+            // The best solution, then every distinct 2n solution
+            if (!result.best_x.empty()) {
+                checked++;
+                invalid += !check(where + ", best", validator, result.best_x, result.best_y,
+                                  maximal || result.best == 2*result.n);
+            }
+            for (size_t k = 0; k < result.solutions.size(); k++) {
+                std::vector<int> xs, ys;
+                for (int cell : result.solutions[k]) {
+                    xs.push_back(cell / result.n);
+                    ys.push_back(cell % result.n);
+                }
+                checked++;
+                invalid += !check(where + ", solution " + std::to_string(k), validator, xs, ys, true);
+            }
+        }
+    }
+
+    std::cout << checked << " solutions checked, " << invalid << " invalid" << std::endl;
+    return (invalid == 0) ? 0 : 1;
+}
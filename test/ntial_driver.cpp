@@ -0,0 +1,119 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <getopt.h>
+#include "../src/ntial_campaign.hpp"
+
+/**
+ * Prints the usage message
+ */
+static void usage(const char *name) {
+    std::cerr << "usage: " << name << " --n N|MIN:MAX [options]\n"
+              << "  -n, --n N|MIN:MAX        problem size, or an inclusive range to sweep\n"
+              << "  -s, --solver NAME        rand (default), dr, symm, fixed or batch\n"
+              << "  -y, --symm               diagonally symmetric solutions (rand, fixed)\n"
+              << "  -p, --propagate          propagate forced moves towards 2n (rand)\n"
+              << "  -d, --tt-depth D         share outcomes of the first D picks between threads (rand)\n"
+              << "  -w, --warm-start FILE    start every run from the points in FILE (rand)\n"
+              << "  -t, --threads T          number of threads (default: OpenMP default)\n"
+              << "  -S, --seed S             base seed (default: from the clock)\n"
+              << "  -r, --runs R             runs per n\n"
+              << "  -m, --until-maximal      stop each n at the first solution with 2n points\n"
+              << "  -T, --time-budget SECS   stop the whole campaign after SECS seconds\n"
+              << "  -c, --cpu-time           count the time budget in process CPU time\n"
+              << "  -f, --format FORMAT      text (default), csv or json\n"
+              << "  -k, --checkpoint FILE    save progress to FILE periodically and at the end\n"
+              << "  -i, --checkpoint-interval SECS  seconds between checkpoints (default: 60)\n"
+              << "  -R, --resume             continue from the checkpoint FILE if it exists\n"
+              << "  -x, --shard K/N          run shard K (0 <= K < N) of a campaign split across N processes\n"
+              << "  -o, --results FILE       save the results to a binary FILE for ntial_merge\n"
+              << "  -v, --validate           check every new best and 2n solution as it is found\n"
+              << "  -e, --telemetry PATH     append a JSON line of progress to a file or Unix socket\n"
+              << "  -I, --telemetry-interval SECS  seconds between telemetry lines (default: 5)\n";
+}
+
+int main (int argc, char *argv[]) {
+    NTIAL_CAMPAIGN::Options options;
+
+    static struct option long_options[] = {
+        {"n",             required_argument, 0, 'n'},
+        {"solver",        required_argument, 0, 's'},
+        {"symm",          no_argument,       0, 'y'},
+        {"propagate",     no_argument,       0, 'p'},
+        {"tt-depth",      required_argument, 0, 'd'},
+        {"warm-start",    required_argument, 0, 'w'},
+        {"threads",       required_argument, 0, 't'},
+        {"seed",          required_argument, 0, 'S'},
+        {"runs",          required_argument, 0, 'r'},
+        {"until-maximal", no_argument,       0, 'm'},
+        {"time-budget",   required_argument, 0, 'T'},
+        {"cpu-time",      no_argument,       0, 'c'},
+        {"format",        required_argument, 0, 'f'},
+        {"checkpoint",    required_argument, 0, 'k'},
+        {"checkpoint-interval", required_argument, 0, 'i'},
+        {"resume",        no_argument,       0, 'R'},
+        {"shard",         required_argument, 0, 'x'},
+        {"results",       required_argument, 0, 'o'},
+        {"validate",      no_argument,       0, 'v'},
+        {"telemetry",     required_argument, 0, 'e'},
+        {"telemetry-interval", required_argument, 0, 'I'},
+        {"help",          no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int c;
+    std::string range, results;
+    while ((c = getopt_long(argc, argv, "n:s:ypd:w:t:S:r:mT:cf:k:i:Rx:o:ve:I:h", long_options, NULL)) != -1) {
+        switch (c) {
+            case 'n': range = optarg; break;
+            case 's': options.solver = optarg; break;
+            case 'y': options.symm = true; break;
+            case 'p': options.propagate = true; break;
+            case 'd': options.tt_depth = atoi(optarg); break;
+            case 'w': options.warm_start = optarg; break;
+            case 't': options.threads = atoi(optarg); break;
+            case 'S': options.seed = strtoull(optarg, NULL, 10); break;
+            case 'r': options.runs = atol(optarg); break;
+            case 'm': options.until_maximal = true; break;
+            case 'T': options.time_budget = atof(optarg); break;
+            case 'c': options.cpu_time = true; break;
+            case 'f': options.format = optarg; break;
+            case 'k': options.checkpoint = optarg; break;
+            case 'i': options.checkpoint_interval = atof(optarg); break;
+            case 'R': options.resume = true; break;
+            case 'x':
+                if (sscanf(optarg, "%d/%d", &options.shard_index, &options.shard_count) != 2) {
+                    options.shard_count = 0;
+                }
+                break;
+            case 'o': results = optarg; break;
+            case 'v': options.validate = true; break;
+            case 'e': options.telemetry = optarg; break;
+            case 'I': options.telemetry_interval = atof(optarg); break;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 1;
+        }
+    }
+
+    // A single size or an inclusive range MIN:MAX
+    size_t colon = range.find(':');
+    options.n_min = atoi(range.c_str());
+    options.n_max = (colon == std::string::npos) ? options.n_min : atoi(range.c_str() + colon + 1);
+
+    std::string error;
+    if (!NTIAL_CAMPAIGN::check(options, error)) {
+        std::cerr << argv[0] << ": " << error << std::endl;
+        usage(argv[0]);
+        return 1;
+    }
+
+    NTIAL_CAMPAIGN campaign (options);
+    bool ok = campaign.run(std::cout);
+    if (!results.empty()) {
+        ok = NTIAL_CAMPAIGN::save_results(results, campaign.get_options(),
+                                          NTIAL_CAMPAIGN::signature(campaign.get_options()), campaign.get_results()) && ok;
+    }
+    return ok ? 0 : 1;
+}
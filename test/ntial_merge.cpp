@@ -0,0 +1,99 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <utility>
+#include <getopt.h>
+#include "../src/ntial_campaign.hpp"
+
+/**
+ * Prints the usage message
+ */
+static void usage(const char *name) {
+    std::cerr << "usage: " << name << " [options] FILE...\n"
+              << "  Merges the binary results files written by ntial_driver --results,\n"
+              << "  typically one per shard, and prints the combined results.\n"
+              << "  -f, --format FORMAT      text (default), csv or json\n"
+              << "  -o, --output FILE        also save the merged results to a binary FILE\n";
+}
+
+int main (int argc, char *argv[]) {
+    std::string format = "text", output;
+
+    static struct option long_options[] = {
+        {"format", required_argument, 0, 'f'},
+        {"output", required_argument, 0, 'o'},
+        {"help",   no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "f:o:h", long_options, NULL)) != -1) {
+        switch (c) {
+            case 'f': format = optarg; break;
+            case 'o': output = optarg; break;
+            default:
+                usage(argv[0]);
+                return (c == 'h') ? 0 : 1;
+        }
+    }
+    if (optind == argc || (format != "text" && format != "csv" && format != "json")) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Results by n, and the shards seen so far to catch a file given twice
+    std::map<int, NTIAL_CAMPAIGN::Result> merged;
+    std::set<std::pair<uint64_t, int> > shards;
+    NTIAL_CAMPAIGN::Options tag;
+    std::string signature, first_signature;
+    int shard_count = 0;
+
+    for (int i = optind; i < argc; i++) {
+        std::vector<NTIAL_CAMPAIGN::Result> results;
+        if (!NTIAL_CAMPAIGN::load_results(argv[i], tag, signature, results)) {
+            return 1;
+        }
+        if (i > optind && signature != first_signature) {
+            std::cerr << argv[i] << ": campaign settings differ from " << argv[optind] << ":\n  "
+                      << signature << "\n  " << first_signature << std::endl;
+            return 1;
+        }
+        first_signature = signature;
+        if (shard_count != 0 && tag.shard_count != shard_count) {
+            std::cerr << argv[i] << ": shard of a campaign split " << tag.shard_count
+                      << " ways, not " << shard_count << std::endl;
+            return 1;
+        }
+        if (!shards.insert(std::make_pair(tag.seed, tag.shard_index)).second) {
+            std::cerr << argv[i] << ": shard " << tag.shard_index << '/' << tag.shard_count
+                      << " of seed " << tag.seed << " was already merged" << std::endl;
+            return 1;
+        }
+        shard_count = tag.shard_count;
+
+        for (auto &result : results) {
+            auto it = merged.find(result.n);
+            if (it == merged.end()) {
+                merged[result.n] = result;
+            } else {
+                NTIAL_CAMPAIGN::merge_result(it->second, result);
+            }
+        }
+    }
+
+    std::vector<NTIAL_CAMPAIGN::Result> results;
+    for (auto &entry : merged) {
+        NTIAL_CAMPAIGN::print_result(std::cout, entry.second, format, results.empty());
+        results.push_back(entry.second);
+    }
+
+    // The merged file covers the whole campaign: shard 0 of 1
+    tag.shard_index = 0;
+    tag.shard_count = 1;
+    if (!output.empty() && !NTIAL_CAMPAIGN::save_results(output, tag, first_signature, results)) {
+        return 1;
+    }
+    return 0;
+}
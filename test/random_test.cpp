@@ -0,0 +1,94 @@
+#include <iostream>
+#include <set>
+#include <utility>
+#include <random>
+#include "../src/ntial_random.hpp"
+#include "../src/ntial_rand.hpp"
+#include "../src/ntial_symm.hpp"
+#include "../src/ntial_fixed.hpp"
+
+/**
+ * Reports a failure if fewer than min distinct values were seen
+ */
+static int expect_spread(const std::set<int> &values, size_t min, const char *what) {
+    if (values.size() >= min) {
+        return 0;
+    }
+    std::cout << "FAILED: " << what << " took only " << values.size() << " values" << std::endl;
+    return 1;
+}
+
+int main () {
+    int n = 12;
+    int failures = 0;
+    uint64_t stream = (uint64_t)n << 32;
+
+    // The first draw after seeding depends on the seed and the call, not on the stream alone
+    std::set<int> by_seed, by_call, by_clock;
+    for (uint64_t s = 0; s < 200; s++) {
+        NTIAL_ENGINE generator (s, stream, 0);
+        std::uniform_int_distribution<int> distribution(0, n-1);
+        by_seed.insert(distribution(generator));
+    }
+    for (uint64_t call = 0; call < 200; call++) {
+        NTIAL_ENGINE generator (1, stream, call);
+        std::uniform_int_distribution<int> distribution(0, n-1);
+        by_call.insert(distribution(generator));
+    }
+    for (uint64_t s = 0; s < 200; s++) {
+        NTIAL_ENGINE generator (s);
+        std::uniform_int_distribution<int> distribution(0, n-1);
+        by_clock.insert(distribution(generator));
+    }
+    failures += expect_spread(by_seed, n, "first draw across seeds");
+    failures += expect_spread(by_call, n, "first draw across calls");
+    failures += expect_spread(by_clock, n, "first draw of single-word keys");
+
+    // Distinct keys give distinct sequences
+    std::set<uint64_t> outputs;
+    for (uint64_t s = 0; s < 16; s++) {
+        for (uint64_t t = 0; t < 16; t++) {
+            for (uint64_t call = 0; call < 16; call++) {
+                NTIAL_ENGINE generator (s, t, call);
+                outputs.insert(generator());
+            }
+        }
+    }
+    if (outputs.size() != 16*16*16) {
+        std::cout << "FAILED: distinct keys share a first output" << std::endl;
+        failures++;
+    }
+
+    // Solvers seeded the way a campaign seeds them start from varied points
+    std::set<int> rand_first, symm_first, fixed_first;
+    NTIAL_RAND prob (n);
+    NTIAL_SYMM symm (n);
+    NTIAL_FIXED<12> fixed;
+    for (uint64_t s = 1; s <= 5; s++) {
+        for (uint64_t call = 0; call < 40; call++) {
+            int x, y;
+            prob.reset();
+            prob.seed(s, stream, call);
+            prob.solve();
+            prob.get_point(0, x, y);
+            rand_first.insert(x*n + y);
+
+            symm.reset();
+            symm.seed(s, stream, call);
+            symm.solve();
+            symm.get_point(0, x, y);
+            symm_first.insert(x*n + y);
+
+            fixed.reset();
+            fixed.seed(s, stream, call);
+            fixed.solve();
+            fixed.get_point(0, x, y);
+            fixed_first.insert(x*n + y);
+        }
+    }
+    failures += expect_spread(rand_first, n, "first point of NTIAL_RAND");
+    failures += expect_spread(symm_first, n, "first point of NTIAL_SYMM");
+    failures += expect_spread(fixed_first, n, "first point of NTIAL_FIXED");
+
+    return failures;
+}
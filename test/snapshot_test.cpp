@@ -0,0 +1,96 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include "../src/ntial_rand.hpp"
+
+int main () {
+    int n = 10;
+    int failures = 0;
+
+    // Build a symmetric prefix once
+    NTIAL_RAND prefix (n);
+    prefix.add_point(0, 1, true);
+    prefix.add_point(2, 2, true);
+
+    NTIAL_RAND::Snapshot snapshot;
+    prefix.save(snapshot);
+
+    std::cout << "PREFIX:" << std::endl;
+    prefix.print_grid();
+
+    // Fork continuations from it
+    NTIAL_RAND prob (n);
+    for (int run = 0; run < 4; run++) {
+      prob.restore(snapshot);
+      prob.seed(run);
+      int chosen = prob.solve_diag_symm();
+
+      NTIAL_RAND::Point* grid = prob.get_grid();
+      if (!grid[IDX2(0,1,n)].chosen || !grid[IDX2(1,0,n)].chosen || !grid[IDX2(2,2,n)].chosen) {
+        std::cout << "FAILED: prefix lost in run " << run << std::endl;
+        failures++;
+      }
+      std::cout << "\nRUN " << run << ", chosen: " << chosen << std::endl;
+      prob.print_grid();
+    }
+
+    // Clones continue independently of the original
+    NTIAL_RAND clone (prefix);
+    clone.seed(42);
+    clone.solve();
+    if (prefix.get_hash() == clone.get_hash()) {
+      std::cout << "FAILED: clone shares state with original" << std::endl;
+      failures++;
+    }
+
+    // Snapshots of another size are rejected and leave the state unchanged
+    NTIAL_RAND small (n - 2);
+    NTIAL_RAND::Snapshot small_snapshot;
+    small.save(small_snapshot);
+    uint64_t before = prob.get_hash();
+    if (prob.restore(small_snapshot) || prob.get_hash() != before) {
+      std::cout << "FAILED: snapshot of another size restored" << std::endl;
+      failures++;
+    }
+
+    // Assignment from another size resizes the target
+    NTIAL_RAND target (n - 2);
+    target = prefix;
+    if (!target.restore(snapshot) || target.get_hash() != prefix.get_hash()) {
+      std::cout << "FAILED: assignment from another size" << std::endl;
+      failures++;
+    }
+    target.seed(7);
+    if (target.solve() > 2*n) {
+      std::cout << "FAILED: resized instance chose too many points" << std::endl;
+      failures++;
+    }
+
+    // A prefix taken without propagation that leaves row 2 short is caught on restore
+    int m = 4;
+    NTIAL_RAND dead (m);
+    dead.add_point(0, 0, false);
+    dead.add_point(0, 1, false);
+    dead.add_point(1, 0, false);
+    dead.add_point(1, 1, false);
+    NTIAL_RAND::Snapshot dead_snapshot;
+    dead.save(dead_snapshot);
+    NTIAL_RAND forced (m);
+    forced.set_propagation(true);
+    forced.restore(dead_snapshot);
+    if (forced.solve() != 4) {
+      std::cout << "FAILED: dead prefix continued after restore" << std::endl;
+      failures++;
+    }
+
+    // With propagation, the same points are rejected as a warm start
+    const char *path = "/tmp/ntial_snapshot_test_seed.txt";
+    std::ofstream(path) << "0 0\n0 1\n1 0\n1 1\n";
+    if (forced.load_seed(path, false)) {
+      std::cout << "FAILED: dead warm start accepted" << std::endl;
+      failures++;
+    }
+    std::remove(path);
+
+    return failures;
+}
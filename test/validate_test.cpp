@@ -0,0 +1,166 @@
+#include <iostream>
+#include <vector>
+#include "../src/ntial_validate.hpp"
+#include "../src/ntial_rand.hpp"
+#include "../src/ntial_symm.hpp"
+#include "../src/ntial_batch.hpp"
+#include "../src/ntial_fixed.hpp"
+
+/**
+ * Reports a check whose outcome differs from the expected one
+ */
+static int expect(bool outcome, bool expected, const char *what, NTIAL_VALIDATE &validator) {
+    if (outcome == expected) {
+        return 0;
+    }
+    std::cout << "FAILED: " << what << " " << validator.get_error() << std::endl;
+    return 1;
+}
+
+/**
+ * Checks that NTIAL_FIXED<N> finds valid, maximal solutions and valid symmetric ones
+ */
+template <int N>
+static int check_fixed(int runs) {
+    int failures = 0;
+    NTIAL_VALIDATE audit (N);
+    NTIAL_FIXED<N> prob;
+    for (int run = 0; run < 2*runs; run++) {
+        bool symm = (run >= runs);
+        prob.reset();
+        prob.seed(run);
+        if (symm) {
+            prob.solve_diag_symm();
+        } else {
+            prob.solve();
+        }
+        std::vector<int> px (prob.get_chosen()), py (prob.get_chosen());
+        for (int k = 0; k < prob.get_chosen(); k++) {
+            prob.get_point(k, px[k], py[k]);
+        }
+        failures += expect(audit.validate(px, py, !symm), true, "NTIAL_FIXED output rejected", audit);
+    }
+    return failures;
+}
+
+int main () {
+    int failures = 0;
+
+    // A 2n solution for n = 4
+    NTIAL_VALIDATE validator (4);
+    std::vector<int> xs = {0, 0, 1, 1, 2, 2, 3, 3};
+    std::vector<int> ys = {1, 2, 0, 3, 0, 3, 1, 2};
+    failures += expect(validator.validate(xs, ys, true), true, "2n solution rejected", validator);
+
+    // Three in a diagonal, with the middle point listed last
+    std::vector<int> dx = {0, 2, 1};
+    std::vector<int> dy = {0, 2, 1};
+    failures += expect(validator.no_three_in_line(dx, dy), false, "diagonal accepted", validator);
+
+    // Three in a line of slope 1/2
+    NTIAL_VALIDATE wide (5);
+    std::vector<int> sx = {0, 2, 4};
+    std::vector<int> sy = {0, 1, 2};
+    failures += expect(wide.no_three_in_line(sx, sy), false, "slope 1/2 accepted", wide);
+
+    // Valid but not maximal: (3, 3) can be added
+    xs.pop_back();
+    ys.pop_back();
+    failures += expect(validator.no_three_in_line(xs, ys), true, "subset rejected", validator);
+    failures += expect(validator.is_maximal(xs, ys), false, "non-maximal set accepted", validator);
+
+    // Repeated and out-of-grid points
+    std::vector<int> rx = {1, 1};
+    std::vector<int> ry = {2, 2};
+    failures += expect(validator.no_three_in_line(rx, ry), false, "repeated point accepted", validator);
+    rx[1] = 4;
+    failures += expect(validator.no_three_in_line(rx, ry), false, "point outside the grid accepted", validator);
+
+    // Solver output is valid and maximal
+    int n = 12;
+    NTIAL_VALIDATE audit (n);
+    NTIAL_RAND prob (n);
+    for (int run = 0; run < 100; run++) {
+        prob.reset();
+        prob.seed(run);
+        prob.solve();
+        std::vector<int> px (prob.get_chosen()), py (prob.get_chosen());
+        for (int k = 0; k < prob.get_chosen(); k++) {
+            prob.get_point(k, px[k], py[k]);
+        }
+        failures += expect(audit.validate(px, py, true), true, "solver output rejected", audit);
+    }
+
+    // With propagation, runs that cannot reach 2n stop early: valid, but maximal only at 2n
+    NTIAL_RAND forced (n);
+    forced.set_propagation(true);
+    int partial = 0;
+    for (int run = 0; run < 100; run++) {
+        forced.reset();
+        forced.seed(run);
+        forced.solve();
+        std::vector<int> px (forced.get_chosen()), py (forced.get_chosen());
+        for (int k = 0; k < forced.get_chosen(); k++) {
+            forced.get_point(k, px[k], py[k]);
+        }
+        bool complete = forced.get_chosen() == 2*n;
+        failures += expect(audit.validate(px, py, complete), true, "propagated output rejected", audit);
+        partial += !complete && !audit.is_maximal(px, py);
+    }
+    if (partial == 0) {
+        std::cout << "FAILED: no propagated run stopped short of a maximal set" << std::endl;
+        failures++;
+    }
+
+    // NTIAL_SYMM output is valid and symmetric; it is maximal only among symmetric sets
+    for (int m : {5, 8, 12, 17}) {
+        NTIAL_VALIDATE symm_audit (m);
+        NTIAL_SYMM symm (m);
+        for (int run = 0; run < 50; run++) {
+            symm.reset();
+            symm.seed(run);
+            symm.solve();
+            std::vector<int> px (symm.get_chosen()), py (symm.get_chosen());
+            std::vector<char> cells (m*m, 0);
+            for (int k = 0; k < symm.get_chosen(); k++) {
+                symm.get_point(k, px[k], py[k]);
+                cells[px[k]*m + py[k]] = 1;
+            }
+            failures += expect(symm_audit.validate(px, py, false), true, "NTIAL_SYMM output rejected", symm_audit);
+            for (int k = 0; k < symm.get_chosen(); k++) {
+                if (!cells[py[k]*m + px[k]]) {
+                    std::cout << "FAILED: NTIAL_SYMM output is not symmetric" << std::endl;
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Every lane of NTIAL_BATCH is valid and maximal, up to its largest size
+    for (int m : {5, 12, 33, 64}) {
+        NTIAL_VALIDATE batch_audit (m);
+        NTIAL_BATCH batch (m);
+        for (int run = 0; run < 10; run++) {
+            batch.reset();
+            batch.seed(run);
+            batch.solve();
+            for (int lane = 0; lane < batch.lanes(); lane++) {
+                std::vector<int> px (batch.get_chosen(lane)), py (batch.get_chosen(lane));
+                for (int k = 0; k < batch.get_chosen(lane); k++) {
+                    batch.get_point(lane, k, px[k], py[k]);
+                }
+                failures += expect(batch_audit.validate(px, py, true), true, "NTIAL_BATCH output rejected", batch_audit);
+            }
+        }
+    }
+
+    // NTIAL_FIXED<N> output, up to its largest size
+    failures += check_fixed<3>(20);
+    failures += check_fixed<8>(20);
+    failures += check_fixed<12>(20);
+    failures += check_fixed<32>(10);
+    failures += check_fixed<64>(5);
+
+    return failures;
+}